@@ -34,22 +34,22 @@ private:
     std::vector<uint32_t> roundKeys_;
     
     static constexpr size_t STATE_SIZE = 16;
-    std::array<uint8_t, STATE_SIZE> state_;
+    using State = std::array<uint8_t, STATE_SIZE>;
     
-    void subBytes();
-    void invSubBytes();
-    void shiftRows();
-    void invShiftRows();
-    void mixColumns();
-    void invMixColumns();
-    void addRoundKey(size_t round);
+    static void subBytes(State& state);
+    static void invSubBytes(State& state);
+    static void shiftRows(State& state);
+    static void invShiftRows(State& state);
+    static void mixColumns(State& state);
+    static void invMixColumns(State& state);
+    void addRoundKey(State& state, size_t round) const;
     
     void keyExpansion(const Byte* key);
     uint32_t subWord(uint32_t word);
     uint32_t rotWord(uint32_t word);
     
-    void stateToBlock(Byte* block);
-    void blockToState(const Byte* block);
+    static void stateToBlock(const State& state, Byte* block);
+    static void blockToState(const Byte* block, State& state);
     
 public:
     Rijndael(KeySize keySize = KeySize::AES128, 
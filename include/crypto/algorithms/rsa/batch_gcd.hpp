@@ -0,0 +1,40 @@
+#pragma once
+#include "big_integer.hpp"
+#include <string>
+#include <vector>
+
+namespace crypto {
+
+class ThreadPool;
+
+namespace rsa {
+
+struct SharedFactor {
+    size_t index;
+    BigInteger modulus;
+    BigInteger factor;
+};
+
+class BatchGCD {
+public:
+
+    static std::vector<BigInteger> computeGcds(const std::vector<BigInteger>& moduli);
+    static std::vector<BigInteger> computeGcds(const std::vector<BigInteger>& moduli, ThreadPool& pool);
+    
+    
+    static std::vector<SharedFactor> findSharedFactors(const std::vector<BigInteger>& moduli);
+    static std::vector<SharedFactor> findSharedFactors(const std::vector<BigInteger>& moduli, ThreadPool& pool);
+    
+    
+    static std::vector<BigInteger> loadModuli(const std::string& path);
+    static std::vector<SharedFactor> auditFile(const std::string& path, ThreadPool& pool);
+
+private:
+    static std::vector<std::vector<BigInteger>> productTree(const std::vector<BigInteger>& moduli,
+                                                            ThreadPool& pool);
+    static std::vector<BigInteger> remainderTree(const std::vector<std::vector<BigInteger>>& tree,
+                                                 ThreadPool& pool);
+};
+
+}
+}
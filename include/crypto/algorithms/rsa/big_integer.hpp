@@ -48,12 +48,21 @@ public:
     static BigInteger modPow(const BigInteger& base, const BigInteger& exp, const BigInteger& mod);
     static BigInteger modInv(const BigInteger& a, const BigInteger& m);
     static BigInteger gcd(const BigInteger& a, const BigInteger& b);
+    static BigInteger pow(const BigInteger& base, uint32_t exp);
+    static BigInteger isqrt(const BigInteger& n);
+    static BigInteger iroot(const BigInteger& n, uint32_t k);
+    static bool isPerfectSquare(const BigInteger& n);
+    static bool isPerfectSquare(const BigInteger& n, BigInteger& root);
+    static bool isPerfectPower(const BigInteger& n, BigInteger& root, uint32_t& exponent);
+    
+    uint32_t modSmall(uint32_t divisor) const;
     
     
     bool isZero() const;
     bool isOne() const;
     bool isEven() const;
     size_t bitLength() const;
+    bool testBit(size_t index) const;
     int sign() const; 
     
     
@@ -61,6 +70,8 @@ public:
     static BigInteger randomInRange(const BigInteger& min, const BigInteger& max);
     
 private:
+    friend class MontgomeryContext;
+    
     std::vector<uint32_t> digits_; 
     bool negative_;
     
@@ -73,6 +84,9 @@ private:
     void subtractDigits(const std::vector<uint32_t>& other);
     static std::vector<uint32_t> multiplyDigits(const std::vector<uint32_t>& a, const std::vector<uint32_t>& b);
     static std::pair<BigInteger, BigInteger> divideWithRemainder(const BigInteger& dividend, const BigInteger& divisor);
+    static std::pair<BigInteger, BigInteger> divideKnuth(const BigInteger& dividend, const BigInteger& divisor);
+    static std::pair<BigInteger, BigInteger> divideNewton(const BigInteger& dividend, const BigInteger& divisor);
+    static BigInteger reciprocal(const BigInteger& divisor);
 };
 
 }
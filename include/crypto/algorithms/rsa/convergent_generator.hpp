@@ -0,0 +1,28 @@
+#pragma once
+#include "big_integer.hpp"
+
+namespace crypto {
+namespace rsa {
+
+class ConvergentGenerator {
+public:
+    ConvergentGenerator(const BigInteger& numerator, const BigInteger& denominator);
+    
+    bool next();
+    
+    const BigInteger& term() const { return term_; }
+    const BigInteger& numerator() const { return h_; }
+    const BigInteger& denominator() const { return k_; }
+    size_t terms() const { return terms_; }
+
+private:
+    BigInteger remainderNumerator_;
+    BigInteger remainderDenominator_;
+    BigInteger term_;
+    BigInteger h_, hPrev_;
+    BigInteger k_, kPrev_;
+    size_t terms_;
+};
+
+}
+}
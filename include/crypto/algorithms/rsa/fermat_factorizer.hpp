@@ -0,0 +1,36 @@
+#pragma once
+#include "big_integer.hpp"
+#include <atomic>
+#include <mutex>
+
+namespace crypto {
+
+class ThreadPool;
+
+namespace rsa {
+
+class FermatFactorizer {
+public:
+    static bool factor(const BigInteger& n, BigInteger& p, BigInteger& q, size_t maxSteps);
+    static bool factor(const BigInteger& n, BigInteger& p, BigInteger& q, size_t maxSteps,
+                       ThreadPool& pool);
+
+private:
+    struct Search {
+        BigInteger n;
+        BigInteger start;
+        size_t maxSteps;
+        size_t stride;
+        std::atomic<size_t> best;
+        std::mutex mutex;
+        BigInteger a;
+        BigInteger b;
+    };
+    
+    static bool run(const BigInteger& n, BigInteger& p, BigInteger& q, size_t maxSteps,
+                    ThreadPool* pool);
+    static void searchStride(Search& search, size_t offset);
+};
+
+}
+}
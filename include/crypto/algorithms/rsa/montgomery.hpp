@@ -0,0 +1,65 @@
+#pragma once
+#include "big_integer.hpp"
+#include <vector>
+#include <cstdint>
+
+namespace crypto {
+namespace rsa {
+
+struct ExponentWindows {
+    struct Step {
+        uint32_t squarings;
+        uint32_t oddValue;
+    };
+
+    size_t width = 1;
+    std::vector<Step> steps;
+
+    static ExponentWindows build(const BigInteger& exponent);
+
+    bool isZero() const { return steps.empty(); }
+};
+
+class MontgomeryContext {
+public:
+    explicit MontgomeryContext(const BigInteger& modulus);
+
+    const BigInteger& modulus() const { return modulus_; }
+    size_t limbs() const { return n_.size(); }
+
+
+    BigInteger toMontgomery(const BigInteger& a) const;
+    BigInteger fromMontgomery(const BigInteger& a) const;
+    BigInteger reduce(const BigInteger& a) const;
+
+    BigInteger multiply(const BigInteger& a, const BigInteger& b) const;
+    BigInteger one() const;
+
+    BigInteger modPow(const BigInteger& base, const BigInteger& exp) const;
+    BigInteger modPow(const BigInteger& base, const ExponentWindows& exp) const;
+
+
+    void mul(const uint32_t* a, const uint32_t* b, uint32_t* out, uint32_t* scratch) const;
+    void add(const uint32_t* a, const uint32_t* b, uint32_t* out) const;
+    void sub(const uint32_t* a, const uint32_t* b, uint32_t* out) const;
+    void halve(uint32_t* a) const;
+    bool isZero(const uint32_t* a) const;
+    void toLimbs(const BigInteger& a, uint32_t* out) const;
+    BigInteger fromLimbs(const uint32_t* a) const;
+    const uint32_t* oneLimbs() const { return one_.data(); }
+    const uint32_t* r2Limbs() const { return r2_.data(); }
+
+private:
+    BigInteger modulus_;
+    std::vector<uint32_t> n_;
+    std::vector<uint32_t> one_;
+    std::vector<uint32_t> r2_;
+    uint32_t nPrime_;
+
+    void powLimbs(const uint32_t* baseMont, const ExponentWindows& exp, uint32_t* out) const;
+    bool geModulus(const uint32_t* a, uint32_t carry) const;
+    void subtractModulus(uint32_t* a) const;
+};
+
+}
+}
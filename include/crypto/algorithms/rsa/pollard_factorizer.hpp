@@ -0,0 +1,32 @@
+#pragma once
+#include "big_integer.hpp"
+#include "montgomery.hpp"
+#include <atomic>
+
+namespace crypto {
+
+class ThreadPool;
+
+namespace rsa {
+
+class PollardFactorizer {
+public:
+    static bool rho(const BigInteger& n, BigInteger& factor, uint64_t maxIterations,
+                    uint32_t increment = 1);
+    static bool rho(const BigInteger& n, BigInteger& factor, uint64_t maxIterations,
+                    ThreadPool& pool);
+    
+    static bool pMinusOne(const BigInteger& n, BigInteger& factor, uint64_t bound);
+
+private:
+    static constexpr uint64_t GCD_BATCH = 128;
+    static constexpr size_t STAGE1_CHECK_INTERVAL = 256;
+    
+    static bool brentWalk(const MontgomeryContext& mont, uint32_t increment,
+                          uint64_t& budget, const std::atomic<bool>& cancel,
+                          BigInteger& factor);
+    static bool splitTrivially(const BigInteger& n, BigInteger& factor);
+};
+
+}
+}
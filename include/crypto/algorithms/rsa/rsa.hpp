@@ -1,5 +1,6 @@
 #pragma once
 #include "rsa_key.hpp"
+#include "rsa_context.hpp"
 #include "../../core/types.hpp"
 #include "../../ciphers/asymmetric_cipher.hpp"
 #include <memory>
@@ -11,6 +12,7 @@ class RSA : public IAsymmetricCipher {
 private:
     RSAKey key_;
     bool hasPrivateKey_;
+    std::shared_ptr<const RSAContext> context_;
     
 public:
     RSA();
@@ -27,6 +29,7 @@ public:
     void setPrivateKey(const BigInteger& n, const BigInteger& d);
     void setKey(const RSAKey& key);
     const RSAKey& getKey() const { return key_; }
+    std::shared_ptr<const RSAContext> getContext() const { return context_; }
     
     ByteArray encrypt(const ByteArray& plaintext) override;
     ByteArray decrypt(const ByteArray& ciphertext) override;
@@ -40,6 +43,8 @@ public:
     ByteArray unpadOAEP(const ByteArray& padded) const;
     
 private:
+    void rebuildContext();
+    
     BigInteger encryptInteger(const BigInteger& m) const;
     BigInteger decryptInteger(const BigInteger& c) const;
 };
@@ -0,0 +1,53 @@
+#pragma once
+#include "rsa_key.hpp"
+#include "montgomery.hpp"
+#include <memory>
+
+namespace crypto {
+namespace rsa {
+
+class RSAContext {
+public:
+    explicit RSAContext(const RSAKey& key);
+
+    static std::shared_ptr<const RSAContext> create(const RSAKey& key);
+
+    const BigInteger& modulus() const { return n_; }
+    size_t modulusBits() const { return modulusBits_; }
+    size_t modulusBytes() const { return modulusBytes_; }
+    size_t blockSize() const { return modulusBytes_ - 1; }
+
+    bool hasPrivateExponent() const { return hasPrivate_; }
+    bool usesCRT() const { return crt_ != nullptr; }
+
+    BigInteger applyPublic(const BigInteger& m) const;
+    BigInteger applyPrivate(const BigInteger& c) const;
+
+private:
+    struct CRTParams {
+        MontgomeryContext p;
+        MontgomeryContext q;
+        ExponentWindows dp;
+        ExponentWindows dq;
+        BigInteger qInvMont;
+
+        CRTParams(const BigInteger& p, const BigInteger& q) : p(p), q(q) {}
+    };
+
+    BigInteger n_;
+    BigInteger e_;
+    BigInteger d_;
+    size_t modulusBits_;
+    size_t modulusBytes_;
+    bool hasPrivate_;
+
+    std::unique_ptr<const MontgomeryContext> mont_;
+    ExponentWindows eWindows_;
+    ExponentWindows dWindows_;
+    std::unique_ptr<const CRTParams> crt_;
+
+    static bool canUseCRT(const RSAKey& key);
+};
+
+}
+}
@@ -0,0 +1,59 @@
+#pragma once
+#include "rsa_key.hpp"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+
+namespace crypto {
+
+class ThreadPool;
+
+namespace rsa {
+
+class RSAKeyPool {
+public:
+    explicit RSAKeyPool(size_t backgroundThreads = 1);
+    ~RSAKeyPool();
+    
+    RSAKeyPool(const RSAKeyPool&) = delete;
+    RSAKeyPool& operator=(const RSAKeyPool&) = delete;
+    
+    void setTarget(size_t keySizeBits, size_t count);
+    size_t target(size_t keySizeBits) const;
+    size_t available(size_t keySizeBits) const;
+    
+    bool tryAcquire(size_t keySizeBits, RSAKey& key);
+    RSAKey acquire(size_t keySizeBits);
+    
+    bool waitForKeys(size_t keySizeBits, size_t count, std::chrono::milliseconds timeout);
+    
+    // save() moves the stocked keys into an owner-only file, written atomically and added
+    // to any keys already saved there, and refills the pool. load() removes the file once
+    // its keys are in memory. Either way a key is held in one place only.
+    void save(const std::string& path);
+    size_t load(const std::string& path);
+
+private:
+    struct Bucket {
+        std::deque<RSAKey> keys;
+        size_t target = 0;
+        size_t pending = 0;
+    };
+    
+    mutable std::mutex mutex_;
+    std::condition_variable keyReady_;
+    std::map<size_t, Bucket> buckets_;
+    std::atomic<bool> stopping_{false};
+    std::unique_ptr<ThreadPool> refillPool_;
+    
+    void scheduleRefillLocked(size_t keySizeBits, Bucket& bucket);
+    void refill(size_t keySizeBits, ThreadPool& pool);
+};
+
+}
+}
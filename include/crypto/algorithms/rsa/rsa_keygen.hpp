@@ -2,24 +2,48 @@
 #include "rsa_key.hpp"
 #include "../../math/prime.hpp"
 #include <cstdint>
+#include <atomic>
+#include <memory>
+#include <utility>
 
 namespace crypto {
+
+class ThreadPool;
+
 namespace rsa {
 
+class MontgomeryContext;
+
 class RSAKeyGenerator {
 public:
     
     static RSAKey generate(size_t keySizeBits = 1024);
+    static RSAKey generate(size_t keySizeBits, ThreadPool& pool, size_t searchersPerPrime = 0);
     
     
     static RSAKey generateSecure(size_t keySizeBits = 1024);
+    static RSAKey generateSecure(size_t keySizeBits, ThreadPool& pool, size_t searchersPerPrime = 0);
     
     
     static bool isVulnerableToWiener(const RSAKey& key);
     
+    
+    static bool isProbablePrime(const BigInteger& n);
+    
+    
+    static BigInteger generateSafePrime(size_t bits);
+    static BigInteger generateSafePrime(size_t bits, ThreadPool& pool, size_t searchers = 0);
+    
 private:
+    struct PrimeSearch;
     
     static BigInteger generatePrime(size_t bits);
+    static bool searchPrime(size_t bits, bool safe, const std::atomic<bool>& cancel, BigInteger& prime);
+    static void runPrimeSearch(const std::shared_ptr<PrimeSearch>& search, size_t bits);
+    static BigInteger awaitPrimeSearch(PrimeSearch& search);
+    static std::pair<BigInteger, BigInteger> generatePrimePair(size_t bits, ThreadPool& pool,
+                                                               size_t searchersPerPrime);
+    static ThreadPool& defaultPool();
     
     
     static BigInteger choosePublicExponent(const BigInteger& phi);
@@ -31,7 +55,9 @@ private:
     static bool satisfiesWienerProtection(const BigInteger& d, const BigInteger& n);
     
     
-    static bool isPrimeMillerRabin(const BigInteger& n, int k = 10);
+    static bool isStrongProbablePrimeBase2(const MontgomeryContext& mont);
+    static bool isStrongLucasProbablePrime(const MontgomeryContext& mont);
+    static bool isSafePrimePair(const BigInteger& q, const BigInteger& p);
 };
 
 }
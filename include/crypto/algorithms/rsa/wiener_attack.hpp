@@ -1,6 +1,6 @@
 #pragma once
 #include "rsa_key.hpp"
-#include "../../math/continued_fraction.hpp"
+#include "convergent_generator.hpp"
 #include <vector>
 
 namespace crypto {
@@ -9,17 +9,17 @@ namespace rsa {
 class WienerAttack {
 public:
     static bool attack(const BigInteger& n, const BigInteger& e, BigInteger& d);
+    static bool attack(const BigInteger& n, const BigInteger& e, BigInteger& d,
+                       BigInteger& p, BigInteger& q);
     
     static bool isVulnerable(const BigInteger& n, const BigInteger& e);
-    
+
 private:
-    
-    static bool testPrivateKey(const BigInteger& n, const BigInteger& e, const BigInteger& d);
-    
-    
-    static bool computePhi(const BigInteger& n, const BigInteger& e, const BigInteger& d, BigInteger& phi);
+
+    static bool checkCandidate(const BigInteger& n, const BigInteger& e,
+                               const BigInteger& k, const BigInteger& d,
+                               BigInteger& p, BigInteger& q);
 };
 
 }
 }
-
@@ -0,0 +1,60 @@
+#pragma once
+#include "big_integer.hpp"
+#include <functional>
+#include <istream>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace crypto {
+
+class ThreadPool;
+
+namespace rsa {
+
+struct WienerFinding {
+    // 1-based: the file line for auditStream()/auditFile(), the key's position for audit().
+    size_t line;
+    BigInteger n;
+    BigInteger e;
+    BigInteger d;
+    BigInteger p;
+    BigInteger q;
+};
+
+struct WienerAuditReport {
+    size_t keysRead = 0;
+    size_t malformed = 0;
+    size_t attacked = 0;
+    std::vector<WienerFinding> vulnerable;
+    
+    double elapsedSeconds = 0.0;
+    double attackSeconds = 0.0;
+    double slowestAttackSeconds = 0.0;
+    
+    double keysPerSecond() const;
+};
+
+class WienerAuditor {
+public:
+    static WienerAuditReport audit(const std::vector<std::pair<BigInteger, BigInteger>>& keys,
+                                   ThreadPool& pool);
+    
+    static WienerAuditReport auditStream(std::istream& input, ThreadPool& pool, size_t batchSize = 1024);
+    static WienerAuditReport auditFile(const std::string& path, ThreadPool& pool, size_t batchSize = 1024);
+
+private:
+    struct Entry {
+        size_t line;
+        std::string n;
+        std::string e;
+    };
+    
+    using KeyLoader = std::function<bool(size_t index, size_t& line, BigInteger& n, BigInteger& e)>;
+    
+    static void auditBatch(size_t count, const KeyLoader& load, ThreadPool& pool, WienerAuditReport& report);
+    static void auditEntries(const std::vector<Entry>& batch, ThreadPool& pool, WienerAuditReport& report);
+};
+
+}
+}
@@ -8,6 +8,20 @@ public:
     virtual void encryptBlock(const Byte* input, Byte* output) = 0;
     
     virtual void decryptBlock(const Byte* input, Byte* output) = 0;
+    
+    virtual void encryptBlocks(const Byte* input, Byte* output, size_t count) {
+        size_t size = blockSize();
+        for (size_t i = 0; i < count; ++i) {
+            encryptBlock(input + i * size, output + i * size);
+        }
+    }
+    
+    virtual void decryptBlocks(const Byte* input, Byte* output, size_t count) {
+        size_t size = blockSize();
+        for (size_t i = 0; i < count; ++i) {
+            decryptBlock(input + i * size, output + i * size);
+        }
+    }
 };
 
 }
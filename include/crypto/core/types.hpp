@@ -43,6 +43,7 @@ constexpr size_t TRIPLE_DES_KEY_SIZE_2KEY = 16;
 constexpr size_t TRIPLE_DES_KEY_SIZE_3KEY = 24;  
 constexpr size_t DEAL_BLOCK_SIZE = 16;           
 constexpr size_t DEAL_KEY_SIZE = 16;             
+constexpr size_t MAX_BLOCK_SIZE = 32;
 
 }
 
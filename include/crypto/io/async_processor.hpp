@@ -5,6 +5,10 @@
 #include <mutex>
 #include <condition_variable>
 #include <atomic>
+#include <algorithm>
+#include <exception>
+#include <functional>
+#include <memory>
 #include <vector>
 
 namespace crypto {
@@ -16,11 +20,17 @@ private:
     std::mutex queueMutex_;
     std::condition_variable condition_;
     std::atomic<bool> stop_{false};
+    std::atomic<size_t> active_{0};
     
 public:
     ThreadPool(size_t threads = std::thread::hardware_concurrency());
     ~ThreadPool();
     
+    size_t size() const { return workers_.size(); }
+    
+    // Tasks a worker is running right now; a snapshot, only meaningful for diagnostics.
+    size_t activeTasks() const { return active_.load(); }
+    
     template<class F>
     auto enqueue(F&& f) -> std::future<decltype(f())> {
         using ReturnType = decltype(f());
@@ -38,6 +48,69 @@ public:
         condition_.notify_one();
         return result;
     }
+    
+    template<class F>
+    void parallelFor(size_t count, F&& body) {
+        struct Loop {
+            std::function<void(size_t)> body;
+            size_t count;
+            std::atomic<size_t> next{0};
+            std::mutex mutex;
+            std::condition_variable finished;
+            size_t done = 0;
+            std::exception_ptr error;
+            
+            void run() {
+                for (size_t i = next++; i < count; i = next++) {
+                    std::exception_ptr failure;
+                    bool skip;
+                    {
+                        std::lock_guard<std::mutex> lock(mutex);
+                        skip = error != nullptr;
+                    }
+                    if (!skip) {
+                        try {
+                            body(i);
+                        } catch (...) {
+                            failure = std::current_exception();
+                        }
+                    }
+                    std::lock_guard<std::mutex> lock(mutex);
+                    if (failure && !error) {
+                        error = failure;
+                    }
+                    if (++done == count) {
+                        finished.notify_all();
+                    }
+                }
+            }
+        };
+        
+        if (count == 0) {
+            return;
+        }
+        
+        auto loop = std::make_shared<Loop>();
+        loop->body = std::forward<F>(body);
+        loop->count = count;
+        
+        size_t helpers = std::min(size(), count - 1);
+        for (size_t i = 0; i < helpers; ++i) {
+            try {
+                enqueue([loop]() { loop->run(); });
+            } catch (...) {
+                break;
+            }
+        }
+        
+        loop->run();
+        
+        std::unique_lock<std::mutex> lock(loop->mutex);
+        loop->finished.wait(lock, [&]() { return loop->done == loop->count; });
+        if (loop->error) {
+            std::rethrow_exception(loop->error);
+        }
+    }
 };
 
 }
\ No newline at end of file
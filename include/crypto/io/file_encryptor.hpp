@@ -5,6 +5,7 @@
 #include <string>
 #include <future>
 #include <memory>
+#include <mutex>
 
 namespace crypto {
 
@@ -13,9 +14,11 @@ private:
     std::shared_ptr<IBlockCipherMode> mode_;
     std::unique_ptr<ThreadPool> threadPool_;
     size_t chunkSize_;
+    std::mutex modeMutex_;
     
     bool encryptFileSync(const std::string& inputFile, const std::string& outputFile);
     bool decryptFileSync(const std::string& inputFile, const std::string& outputFile);
+    bool streamFile(const std::string& inputFile, const std::string& outputFile, bool encrypting);
     
 public:
     AsyncFileEncryptor(std::shared_ptr<IBlockCipherMode> mode, 
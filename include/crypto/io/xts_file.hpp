@@ -0,0 +1,37 @@
+#pragma once
+#include "../modes/xts.hpp"
+#include "../core/types.hpp"
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <string>
+
+namespace crypto {
+
+// Random-access view of an XTS-encrypted image; the image always holds whole sectors.
+class XTSFile {
+private:
+    std::shared_ptr<XTSMode> mode_;
+    std::fstream file_;
+    uint64_t size_;
+    std::mutex mutex_;
+    
+    void readSectors(uint64_t firstSector, Byte* output, size_t sectors);
+    void writeSectors(uint64_t firstSector, Byte* data, size_t sectors);
+
+public:
+    XTSFile(const std::string& path, std::shared_ptr<XTSMode> mode);
+    
+    uint64_t size() const { return size_; }
+    
+    size_t read(uint64_t offset, Byte* output, size_t length);
+    ByteArray read(uint64_t offset, size_t length);
+    
+    // Writing past the end grows the image with zero-filled sectors.
+    void write(uint64_t offset, const Byte* data, size_t length);
+    void write(uint64_t offset, const ByteArray& data);
+    
+    void flush();
+};
+
+}
\ No newline at end of file
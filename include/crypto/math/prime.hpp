@@ -1,5 +1,7 @@
 #pragma once
 #include <cstdint>
+#include <cstddef>
+#include <functional>
 #include <vector>
 
 namespace crypto {
@@ -7,7 +9,7 @@ namespace math {
 
 bool isPrime(uint64_t n);
 
-bool isPrimeMillerRabin(uint64_t n, int k = 10);
+bool isPrimeMillerRabin(uint64_t n);
 
 uint64_t generatePrime(uint64_t minBits = 16);
 
@@ -15,6 +17,32 @@ uint64_t generatePrimeInRange(uint64_t min, uint64_t max);
 
 std::vector<uint64_t> sieveOfEratosthenes(uint64_t limit);
 
+const std::vector<uint32_t>& smallPrimes();
+
+void forEachPrime(uint64_t low, uint64_t high, const std::function<void(uint64_t)>& visit);
+
+// visitBlock runs on worker threads; each block is ascending, blocks arrive in any order.
+void forEachPrimeParallel(uint64_t low, uint64_t high,
+                          const std::function<void(const std::vector<uint64_t>&)>& visitBlock,
+                          size_t threads = 0);
+
+uint64_t countPrimes(uint64_t low, uint64_t high, size_t threads = 0);
+
+class PrimeIterator {
+public:
+    explicit PrimeIterator(uint64_t start = 0);
+    
+    uint64_t next();
+
+private:
+    uint64_t segmentLow_;
+    std::vector<uint64_t> buffer_;
+    size_t position_;
+    std::vector<uint32_t> sievingPrimes_;
+    
+    void fillSegment();
+};
+
 }
 }
 
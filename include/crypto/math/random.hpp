@@ -1,14 +1,31 @@
 #pragma once
 #include "../core/types.hpp"
 #include <cstddef>
+#include <cstdint>
+#include <limits>
 
 namespace crypto {
 namespace math {
 
+void chacha20Block(const uint32_t key[8], uint32_t counter, const uint32_t nonce[3], Byte out[64]);
+
+// Thread-local ChaCha20 generator seeded from getrandom(); reseeds in a forked child.
+class SecureRandom {
+public:
+    using result_type = uint64_t;
+    
+    static constexpr result_type min() { return 0; }
+    static constexpr result_type max() { return std::numeric_limits<result_type>::max(); }
+    
+    result_type operator()();
+    
+    static void fill(Byte* out, size_t count);
+    static uint64_t uniform(uint64_t bound);
+};
+
 ByteArray randomBytes(size_t count);
 
 Key randomKey(size_t size);
 
 }
 }
-
@@ -0,0 +1,71 @@
+#pragma once
+#include "../core/types.hpp"
+#include "../io/async_processor.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <vector>
+
+namespace crypto {
+
+constexpr size_t PARALLEL_MIN_BLOCKS_PER_TASK = 1024;
+
+inline size_t blockRangeLength(const ThreadPool& pool, size_t blocks) {
+    size_t tasks = std::min((pool.size() + 1) * 4,
+                            (blocks + PARALLEL_MIN_BLOCKS_PER_TASK - 1) / PARALLEL_MIN_BLOCKS_PER_TASK);
+    return (blocks + tasks - 1) / tasks;
+}
+
+// body(firstBlock, blockCount) runs on pool workers over disjoint, ascending ranges.
+template<typename F>
+void forEachBlockRange(ThreadPool& pool, size_t blocks, F&& body) {
+    if (blocks == 0) {
+        return;
+    }
+    
+    size_t perTask = blockRangeLength(pool, blocks);
+    pool.parallelFor((blocks + perTask - 1) / perTask, [&](size_t task) {
+        size_t first = task * perTask;
+        body(first, std::min(perTask, blocks - first));
+    });
+}
+
+// Runs body(0, blocks) inline unless a pool is given and the input is worth splitting.
+template<typename F>
+void runBlockRanges(ThreadPool* pool, size_t blocks, F&& body) {
+    if (pool && blocks >= 2 * PARALLEL_MIN_BLOCKS_PER_TASK) {
+        forEachBlockRange(*pool, blocks, body);
+    } else if (blocks > 0) {
+        body(0, blocks);
+    }
+}
+
+// Chained decryption: body(firstBlock, blockCount, previous) receives a copy of the
+// ciphertext block preceding firstBlock (or iv), taken before any range writes output,
+// so input and output may alias.
+template<typename F>
+void runChainedRanges(ThreadPool* pool, const Byte* input, const Byte* iv,
+                      size_t blockSize, size_t blocks, F&& body) {
+    if (!pool || blocks < 2 * PARALLEL_MIN_BLOCKS_PER_TASK) {
+        if (blocks > 0) {
+            body(0, blocks, iv);
+        }
+        return;
+    }
+    
+    size_t perTask = blockRangeLength(*pool, blocks);
+    size_t tasks = (blocks + perTask - 1) / perTask;
+    std::vector<Byte> chain(tasks * blockSize);
+    std::memcpy(chain.data(), iv, blockSize);
+    for (size_t task = 1; task < tasks; ++task) {
+        std::memcpy(chain.data() + task * blockSize,
+                    input + (task * perTask - 1) * blockSize, blockSize);
+    }
+    
+    pool->parallelFor(tasks, [&](size_t task) {
+        size_t first = task * perTask;
+        body(first, std::min(perTask, blocks - first), chain.data() + task * blockSize);
+    });
+}
+
+}
@@ -1,18 +1,29 @@
 #pragma once
 #include "mode.hpp"
+#include <cstdint>
+#include <istream>
 
 namespace crypto {
 
+class ThreadPool;
+
 class CFBMode : public IBlockCipherMode {
 private:
+    static constexpr size_t BATCH_BLOCKS = 16;
+    
     std::shared_ptr<IBlockCipher> cipher_;
     std::unique_ptr<IPadding> padding_;
+    std::shared_ptr<ThreadPool> pool_;
     ByteArray iv_;
     ByteArray feedback_;
     bool usePadding_;
     size_t blockSize_;
     size_t segmentSize_;
     
+    void shiftFeedback(const Byte* segment);
+    void decryptChained(const Byte* input, Byte* output, size_t blocks, const Byte* previous) const;
+    void decryptWindow(const Byte* input, Byte* output, size_t length, const Byte* previous) const;
+    
 public:
     CFBMode(std::shared_ptr<IBlockCipher> cipher, 
             std::unique_ptr<IPadding> padding = nullptr,
@@ -25,6 +36,7 @@ public:
     
     void setCipher(std::shared_ptr<IBlockCipher> cipher) override;
     void setPadding(std::unique_ptr<IPadding> padding) override;
+    void setThreadPool(std::shared_ptr<ThreadPool> pool);
     bool usesPadding() const override { return false; }
     
     void setIV(const ByteArray& iv) override;
@@ -37,7 +49,15 @@ public:
     void encrypt(const Byte* input, Byte* output, size_t length) override;
     void decrypt(const Byte* input, Byte* output, size_t length) override;
     
+    ByteArray decryptRange(const ByteArray& ciphertext, uint64_t blockOffset, size_t blocks) const;
+    ByteArray decryptRange(std::istream& ciphertext, uint64_t blockOffset, size_t blocks) const;
+    
     void reset() override;
+    
+protected:
+    StreamLayout streamLayout() const override {
+        return {blockSize_, segmentSize_, usePadding_ ? padding_.get() : nullptr};
+    }
 };
 
 }
\ No newline at end of file
@@ -4,17 +4,22 @@
 
 namespace crypto {
 
+class ThreadPool;
+
 class CTRMode : public IBlockCipherMode {
 private:
+    static constexpr size_t BATCH_BLOCKS = 16;
+    
     std::shared_ptr<IBlockCipher> cipher_;
     std::unique_ptr<IPadding> padding_;
+    std::shared_ptr<ThreadPool> pool_;
     ByteArray nonce_;
-    uint64_t counter_;
+    uint64_t position_;
     bool usePadding_;
     size_t blockSize_;
     
-    void incrementCounter();
-    void getCounterBlock(Byte* block);
+    void counterBlock(uint64_t index, Byte* block) const;
+    void processBlocks(uint64_t firstBlock, const Byte* input, Byte* output, size_t length) const;
     
 public:
     CTRMode(std::shared_ptr<IBlockCipher> cipher, 
@@ -25,6 +30,7 @@ public:
     
     void setCipher(std::shared_ptr<IBlockCipher> cipher) override;
     void setPadding(std::unique_ptr<IPadding> padding) override;
+    void setThreadPool(std::shared_ptr<ThreadPool> pool);
     bool usesPadding() const override { return false; }
     
     void setIV(const ByteArray& iv) override;
@@ -37,7 +43,16 @@ public:
     void encrypt(const Byte* input, Byte* output, size_t length) override;
     void decrypt(const Byte* input, Byte* output, size_t length) override;
     
+    void process(uint64_t offset, const Byte* input, Byte* output, size_t length) const;
+    void seek(uint64_t byteOffset);
+    uint64_t position() const { return position_; }
+    
     void reset() override;
+    
+protected:
+    StreamLayout streamLayout() const override {
+        return {blockSize_, 1, usePadding_ ? padding_.get() : nullptr};
+    }
 };
 
 }
\ No newline at end of file
@@ -3,10 +3,13 @@
 
 namespace crypto {
 
+class ThreadPool;
+
 class ECBMode : public IBlockCipherMode {
 private:
     std::shared_ptr<IBlockCipher> cipher_;
     std::unique_ptr<IPadding> padding_;
+    std::shared_ptr<ThreadPool> pool_;
     bool usePadding_;
     size_t blockSize_;
     
@@ -19,6 +22,7 @@ public:
     
     void setCipher(std::shared_ptr<IBlockCipher> cipher) override;
     void setPadding(std::unique_ptr<IPadding> padding) override;
+    void setThreadPool(std::shared_ptr<ThreadPool> pool);
     bool usesPadding() const override { return usePadding_; }
     
     void setIV(const ByteArray&) override {}
@@ -32,6 +36,11 @@ public:
     void decrypt(const Byte* input, Byte* output, size_t length) override;
     
     void reset() override {}
+    
+protected:
+    StreamLayout streamLayout() const override {
+        return {blockSize_, blockSize_, usePadding_ ? padding_.get() : nullptr};
+    }
 };
 
 }
\ No newline at end of file
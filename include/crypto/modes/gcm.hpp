@@ -0,0 +1,69 @@
+#pragma once
+#include "mode.hpp"
+#include "ghash.hpp"
+#include <cstdint>
+
+namespace crypto {
+
+class GCMMode : public IBlockCipherMode {
+public:
+    static constexpr size_t TAG_SIZE = 16;
+    static constexpr size_t NONCE_SIZE = 12;
+
+private:
+    static constexpr size_t BATCH_BLOCKS = 16;
+    
+    std::shared_ptr<IBlockCipher> cipher_;
+    std::unique_ptr<GHash> ghash_;
+    Byte hashKey_[GHash::BLOCK_SIZE];
+    ByteArray iv_;
+    ByteArray aad_;
+    ByteArray tag_;
+    ByteArray expectedTag_;
+    bool hardwareGHash_;
+    bool ivUsed_;
+    
+    void bindCipher();
+    void prepareHash();
+    void initialCounter(Byte* counter);
+    void process(bool encrypting, const Byte* input, Byte* output, size_t length);
+    void sealWithFreshIV(const Byte* input, Byte* output, size_t length);
+
+public:
+    GCMMode(std::shared_ptr<IBlockCipher> cipher,
+            std::unique_ptr<IPadding> padding = nullptr);
+    
+    CipherMode mode() const override { return CipherMode::GCM; }
+    std::string name() const override { return "GCM"; }
+    
+    void setCipher(std::shared_ptr<IBlockCipher> cipher) override;
+    void setPadding(std::unique_ptr<IPadding> padding) override;
+    bool usesPadding() const override { return false; }
+    
+    // Each IV encrypts one message: a second encrypt() throws until setIV() or
+    // generateRandomIV() supplies a new one. Decryption does not consume the IV.
+    void setIV(const ByteArray& iv) override;
+    ByteArray getIV() const override;
+    void generateRandomIV() override;
+    
+    void setAAD(const ByteArray& aad);
+    const ByteArray& getAAD() const { return aad_; }
+    
+    // Tag of the last message processed; decrypt(const Byte*, ...) checks against setTag().
+    const ByteArray& getTag() const { return tag_; }
+    void setTag(const ByteArray& tag);
+    
+    void setHardwareGHash(bool enabled);
+    bool usesHardwareGHash() const;
+    
+    // The ByteArray overloads append the tag to the ciphertext and verify it on decryption.
+    ByteArray encrypt(const ByteArray& plaintext) override;
+    ByteArray decrypt(const ByteArray& ciphertext) override;
+    
+    void encrypt(const Byte* input, Byte* output, size_t length) override;
+    void decrypt(const Byte* input, Byte* output, size_t length) override;
+    
+    void reset() override;
+};
+
+}
\ No newline at end of file
@@ -0,0 +1,37 @@
+#pragma once
+#include "../core/types.hpp"
+#include <cstdint>
+
+namespace crypto {
+
+class GHash {
+public:
+    static constexpr size_t BLOCK_SIZE = 16;
+    static constexpr size_t AGGREGATE_BLOCKS = 4;
+    
+    explicit GHash(const Byte* hashKey, bool allowHardware = true);
+    
+    static bool hardwareAvailable();
+    bool usesHardware() const { return useClmul_; }
+    
+    void reset();
+    
+    void update(const Byte* blocks, size_t count);
+    
+    // Absorbs length bytes, zero-padding the final partial block.
+    void updatePadded(const Byte* data, size_t length);
+    
+    void digest(Byte* output) const;
+
+private:
+    uint64_t tableHigh_[16];
+    uint64_t tableLow_[16];
+    alignas(16) Byte powers_[AGGREGATE_BLOCKS][BLOCK_SIZE];
+    Byte state_[BLOCK_SIZE];
+    bool useClmul_;
+    
+    void multiplyPortable(Byte* x) const;
+    void updatePortable(const Byte* blocks, size_t count);
+};
+
+}
\ No newline at end of file
@@ -12,7 +12,9 @@ enum class CipherMode {
     CFB,
     OFB,
     CTR,
-    RANDOM_DELTA
+    RANDOM_DELTA,
+    GCM,
+    XTS
 };
 
 class IBlockCipherMode {
@@ -45,12 +47,48 @@ public:
     
     virtual void reset() = 0;
     
+    // In-place one-shot: encryptInPlace() pads buffer[0, length) within capacity and
+    // returns the ciphertext length; decryptInPlace() returns the unpadded length.
+    size_t encryptInPlace(Byte* buffer, size_t length, size_t capacity);
+    
+    size_t decryptInPlace(Byte* buffer, size_t length);
+    
+    // Streaming: update() writes at most length + MAX_BLOCK_SIZE bytes and finalize()
+    // at most MAX_BLOCK_SIZE; both return the number of bytes written.
+    void startEncryption();
+    
+    void startDecryption();
+    
+    size_t update(const Byte* input, size_t length, Byte* output);
+    
+    size_t finalize(Byte* output);
+    
     static std::unique_ptr<IBlockCipherMode> create(
         CipherMode mode,
         std::shared_ptr<IBlockCipher> cipher,
         std::unique_ptr<IPadding> padding = nullptr,
         const ByteArray& iv = ByteArray()
     );
+    
+protected:
+    struct StreamLayout {
+        size_t blockSize;
+        size_t unit;
+        IPadding* padding;
+    };
+    
+    virtual StreamLayout streamLayout() const;
+    
+    virtual void streamStart(bool encrypting);
+    
+    virtual void streamProcess(bool encrypting, const Byte* input, Byte* output, size_t length);
+    
+private:
+    ByteArray streamPending_;
+    bool streamActive_ = false;
+    bool streamEncrypting_ = true;
+    
+    void startStream(bool encrypting);
 };
 
 }
\ No newline at end of file
@@ -36,6 +36,11 @@ public:
     
     void reset() override;
     
+protected:
+    StreamLayout streamLayout() const override {
+        return {blockSize_, 1, usePadding_ ? padding_.get() : nullptr};
+    }
+    
 private:
     void generateKeystream();
     void generateMoreKeystream();
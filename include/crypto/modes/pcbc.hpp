@@ -8,9 +8,16 @@ private:
     std::shared_ptr<IBlockCipher> cipher_;
     std::unique_ptr<IPadding> padding_;
     ByteArray iv_;
+    ByteArray streamPlain_;
+    ByteArray streamCipher_;
     bool usePadding_;
     size_t blockSize_;
     
+    void encryptChained(const Byte* input, Byte* output, size_t blocks,
+                        Byte* previousPlain, Byte* previousCipher);
+    void decryptChained(const Byte* input, Byte* output, size_t blocks,
+                        Byte* previousPlain, Byte* previousCipher);
+    
 public:
     PCBCMode(std::shared_ptr<IBlockCipher> cipher, 
              std::unique_ptr<IPadding> padding = nullptr);
@@ -33,6 +40,13 @@ public:
     void decrypt(const Byte* input, Byte* output, size_t length) override;
     
     void reset() override;
+    
+protected:
+    StreamLayout streamLayout() const override {
+        return {blockSize_, blockSize_, usePadding_ ? padding_.get() : nullptr};
+    }
+    void streamStart(bool encrypting) override;
+    void streamProcess(bool encrypting, const Byte* input, Byte* output, size_t length) override;
 };
 
 }
\ No newline at end of file
@@ -1,14 +1,22 @@
 #pragma once
 #include "mode.hpp"
+#include <cstdint>
+#include <istream>
 
 namespace crypto {
 
+class ThreadPool;
+
 class RandomDeltaMode : public IBlockCipherMode {
 private:
+    static constexpr size_t BATCH_BLOCKS = 16;
+    
     std::shared_ptr<IBlockCipher> cipher_;
     std::unique_ptr<IPadding> padding_;
+    std::shared_ptr<ThreadPool> pool_;
     ByteArray iv_;
     ByteArray delta_;
+    ByteArray chain_;
     bool usePadding_;
     size_t blockSize_;
     
@@ -21,6 +29,7 @@ public:
     
     void setCipher(std::shared_ptr<IBlockCipher> cipher) override;
     void setPadding(std::unique_ptr<IPadding> padding) override;
+    void setThreadPool(std::shared_ptr<ThreadPool> pool);
     bool usesPadding() const override { return usePadding_; }
     
     void setIV(const ByteArray& iv) override;
@@ -33,10 +42,23 @@ public:
     void encrypt(const Byte* input, Byte* output, size_t length) override;
     void decrypt(const Byte* input, Byte* output, size_t length) override;
     
+    ByteArray decryptRange(const ByteArray& ciphertext, uint64_t blockOffset, size_t blocks) const;
+    ByteArray decryptRange(std::istream& ciphertext, uint64_t blockOffset, size_t blocks) const;
+    
     void reset() override;
     
+protected:
+    StreamLayout streamLayout() const override {
+        return {blockSize_, blockSize_, usePadding_ ? padding_.get() : nullptr};
+    }
+    void streamStart(bool encrypting) override;
+    void streamProcess(bool encrypting, const Byte* input, Byte* output, size_t length) override;
+    
 private:
-    void generateDelta(size_t blockIndex);
+    void generateDelta();
+    void encryptChained(const Byte* input, Byte* output, size_t blocks, Byte* currentIV) const;
+    void decryptChained(const Byte* input, Byte* output, size_t blocks, Byte* currentIV) const;
+    void decryptWindow(const Byte* input, Byte* output, size_t blocks, const Byte* previous) const;
 };
 
 }
\ No newline at end of file
@@ -0,0 +1,63 @@
+#pragma once
+#include "mode.hpp"
+#include <cstdint>
+
+namespace crypto {
+
+class ThreadPool;
+
+class XTSMode : public IBlockCipherMode {
+public:
+    static constexpr size_t DEFAULT_SECTOR_SIZE = 4096;
+
+private:
+    static constexpr size_t BATCH_BLOCKS = 16;
+    
+    std::shared_ptr<IBlockCipher> cipher_;
+    std::shared_ptr<IBlockCipher> tweakCipher_;
+    std::shared_ptr<ThreadPool> pool_;
+    size_t sectorSize_;
+    uint64_t sector_;
+    
+    static void checkCipher(const IBlockCipher* cipher);
+    void processSector(bool encrypting, uint64_t sector, const Byte* input, Byte* output, size_t length) const;
+    void processSectors(bool encrypting, uint64_t firstSector, const Byte* input, Byte* output, size_t length) const;
+
+public:
+    XTSMode(std::shared_ptr<IBlockCipher> cipher,
+            std::shared_ptr<IBlockCipher> tweakCipher,
+            size_t sectorSize = DEFAULT_SECTOR_SIZE);
+    
+    CipherMode mode() const override { return CipherMode::XTS; }
+    std::string name() const override { return "XTS"; }
+    
+    void setCipher(std::shared_ptr<IBlockCipher> cipher) override;
+    void setTweakCipher(std::shared_ptr<IBlockCipher> cipher);
+    void setPadding(std::unique_ptr<IPadding> padding) override;
+    void setThreadPool(std::shared_ptr<ThreadPool> pool);
+    bool usesPadding() const override { return false; }
+    
+    // The IV is the 16-byte little-endian number of the first sector encrypt()/decrypt() touch.
+    void setIV(const ByteArray& iv) override;
+    ByteArray getIV() const override;
+    void generateRandomIV() override;
+    
+    void setSector(uint64_t sector) { sector_ = sector; }
+    uint64_t sector() const { return sector_; }
+    size_t sectorSize() const { return sectorSize_; }
+    
+    ByteArray encrypt(const ByteArray& plaintext) override;
+    ByteArray decrypt(const ByteArray& ciphertext) override;
+    
+    void encrypt(const Byte* input, Byte* output, size_t length) override;
+    void decrypt(const Byte* input, Byte* output, size_t length) override;
+    
+    // length covers consecutive sectors from firstSector; only the last may be short
+    // (at least 16 bytes, handled with ciphertext stealing).
+    void encryptSectors(uint64_t firstSector, const Byte* input, Byte* output, size_t length) const;
+    void decryptSectors(uint64_t firstSector, const Byte* input, Byte* output, size_t length) const;
+    
+    void reset() override;
+};
+
+}
\ No newline at end of file
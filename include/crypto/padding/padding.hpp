@@ -23,6 +23,10 @@ public:
     virtual ByteArray unpad(const ByteArray& paddedData) const = 0;
     virtual bool validate(const ByteArray& paddedData) const = 0;
     
+    // Pads buffer[0, length) within buffer[0, capacity) and returns the padded length.
+    virtual size_t padInPlace(Byte* buffer, size_t length, size_t capacity, size_t blockSize) = 0;
+    virtual size_t unpaddedLength(const Byte* paddedData, size_t length) const = 0;
+    
     static std::unique_ptr<IPadding> create(PaddingType type);
     static std::unique_ptr<IPadding> create(const std::string& name);
 };
@@ -35,6 +39,9 @@ public:
     ByteArray pad(const ByteArray& data, size_t blockSize) override;
     ByteArray unpad(const ByteArray& paddedData) const override;
     bool validate(const ByteArray& paddedData) const override;
+    
+    size_t padInPlace(Byte* buffer, size_t length, size_t capacity, size_t blockSize) override;
+    size_t unpaddedLength(const Byte* paddedData, size_t length) const override;
 };
 
 class PKCS7Padding : public IPadding {
@@ -45,6 +52,9 @@ public:
     ByteArray pad(const ByteArray& data, size_t blockSize) override;
     ByteArray unpad(const ByteArray& paddedData) const override;
     bool validate(const ByteArray& paddedData) const override;
+    
+    size_t padInPlace(Byte* buffer, size_t length, size_t capacity, size_t blockSize) override;
+    size_t unpaddedLength(const Byte* paddedData, size_t length) const override;
 };
 
 class ANSIX923Padding : public IPadding {
@@ -55,6 +65,9 @@ public:
     ByteArray pad(const ByteArray& data, size_t blockSize) override;
     ByteArray unpad(const ByteArray& paddedData) const override;
     bool validate(const ByteArray& paddedData) const override;
+    
+    size_t padInPlace(Byte* buffer, size_t length, size_t capacity, size_t blockSize) override;
+    size_t unpaddedLength(const Byte* paddedData, size_t length) const override;
 };
 
 class ISO10126Padding : public IPadding {
@@ -65,6 +78,9 @@ public:
     ByteArray pad(const ByteArray& data, size_t blockSize) override;
     ByteArray unpad(const ByteArray& paddedData) const override;
     bool validate(const ByteArray& paddedData) const override;
+    
+    size_t padInPlace(Byte* buffer, size_t length, size_t capacity, size_t blockSize) override;
+    size_t unpaddedLength(const Byte* paddedData, size_t length) const override;
 };
 
 inline std::unique_ptr<IPadding> IPadding::create(PaddingType type) {
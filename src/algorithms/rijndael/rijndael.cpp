@@ -38,83 +38,83 @@ bool Rijndael::isValidKey(const Key& key) const {
     return key.size() == keyBytes_;
 }
 
-void Rijndael::blockToState(const Byte* block) {
+void Rijndael::blockToState(const Byte* block, State& state) {
     for (size_t i = 0; i < 4; ++i) {
         for (size_t j = 0; j < 4; ++j) {
-            state_[i + 4*j] = block[i + 4*j];
+            state[i + 4*j] = block[i + 4*j];
         }
     }
 }
 
-void Rijndael::stateToBlock(Byte* block) {
+void Rijndael::stateToBlock(const State& state, Byte* block) {
     for (size_t i = 0; i < 4; ++i) {
         for (size_t j = 0; j < 4; ++j) {
-            block[i + 4*j] = state_[i + 4*j];
+            block[i + 4*j] = state[i + 4*j];
         }
     }
 }
 
-void Rijndael::subBytes() {
+void Rijndael::subBytes(State& state) {
     for (size_t i = 0; i < STATE_SIZE; ++i) {
-        state_[i] = S_BOX[state_[i]];
+        state[i] = S_BOX[state[i]];
     }
 }
 
-void Rijndael::invSubBytes() {
+void Rijndael::invSubBytes(State& state) {
     for (size_t i = 0; i < STATE_SIZE; ++i) {
-        state_[i] = INV_S_BOX[state_[i]];
+        state[i] = INV_S_BOX[state[i]];
     }
 }
 
-void Rijndael::shiftRows() {
+void Rijndael::shiftRows(State& state) {
     uint8_t temp;
     
-    temp = state_[1]; state_[1] = state_[5]; state_[5] = state_[9]; state_[9] = state_[13]; state_[13] = temp;
+    temp = state[1]; state[1] = state[5]; state[5] = state[9]; state[9] = state[13]; state[13] = temp;
     
-    temp = state_[2]; state_[2] = state_[10]; state_[10] = temp; temp = state_[6]; state_[6] = state_[14]; state_[14] = temp;
+    temp = state[2]; state[2] = state[10]; state[10] = temp; temp = state[6]; state[6] = state[14]; state[14] = temp;
     
-    temp = state_[3]; state_[3] = state_[15]; state_[15] = state_[11]; state_[11] = state_[7]; state_[7] = temp;
+    temp = state[3]; state[3] = state[15]; state[15] = state[11]; state[11] = state[7]; state[7] = temp;
 }
 
-void Rijndael::invShiftRows() {
+void Rijndael::invShiftRows(State& state) {
     uint8_t temp;
     
-    temp = state_[13]; state_[13] = state_[9]; state_[9] = state_[5]; state_[5] = state_[1]; state_[1] = temp;
+    temp = state[13]; state[13] = state[9]; state[9] = state[5]; state[5] = state[1]; state[1] = temp;
     
-    temp = state_[2]; state_[2] = state_[10]; state_[10] = temp; temp = state_[6]; state_[6] = state_[14]; state_[14] = temp;
+    temp = state[2]; state[2] = state[10]; state[10] = temp; temp = state[6]; state[6] = state[14]; state[14] = temp;
     
-    temp = state_[3]; state_[3] = state_[7]; state_[7] = state_[11]; state_[11] = state_[15]; state_[15] = temp;
+    temp = state[3]; state[3] = state[7]; state[7] = state[11]; state[11] = state[15]; state[15] = temp;
 }
 
-void Rijndael::mixColumns() {
+void Rijndael::mixColumns(State& state) {
     uint8_t temp[4];
     for (size_t c = 0; c < 4; ++c) {
-        temp[0] = MULT_2[state_[4*c]] ^ MULT_3[state_[4*c+1]] ^ state_[4*c+2] ^ state_[4*c+3];
-        temp[1] = state_[4*c] ^ MULT_2[state_[4*c+1]] ^ MULT_3[state_[4*c+2]] ^ state_[4*c+3];
-        temp[2] = state_[4*c] ^ state_[4*c+1] ^ MULT_2[state_[4*c+2]] ^ MULT_3[state_[4*c+3]];
-        temp[3] = MULT_3[state_[4*c]] ^ state_[4*c+1] ^ state_[4*c+2] ^ MULT_2[state_[4*c+3]];
-        state_[4*c] = temp[0]; state_[4*c+1] = temp[1]; state_[4*c+2] = temp[2]; state_[4*c+3] = temp[3];
+        temp[0] = MULT_2[state[4*c]] ^ MULT_3[state[4*c+1]] ^ state[4*c+2] ^ state[4*c+3];
+        temp[1] = state[4*c] ^ MULT_2[state[4*c+1]] ^ MULT_3[state[4*c+2]] ^ state[4*c+3];
+        temp[2] = state[4*c] ^ state[4*c+1] ^ MULT_2[state[4*c+2]] ^ MULT_3[state[4*c+3]];
+        temp[3] = MULT_3[state[4*c]] ^ state[4*c+1] ^ state[4*c+2] ^ MULT_2[state[4*c+3]];
+        state[4*c] = temp[0]; state[4*c+1] = temp[1]; state[4*c+2] = temp[2]; state[4*c+3] = temp[3];
     }
 }
 
-void Rijndael::invMixColumns() {
+void Rijndael::invMixColumns(State& state) {
     uint8_t temp[4];
     for (size_t c = 0; c < 4; ++c) {
-        temp[0] = MULT_14[state_[4*c]] ^ MULT_11[state_[4*c+1]] ^ MULT_13[state_[4*c+2]] ^ MULT_9[state_[4*c+3]];
-        temp[1] = MULT_9[state_[4*c]] ^ MULT_14[state_[4*c+1]] ^ MULT_11[state_[4*c+2]] ^ MULT_13[state_[4*c+3]];
-        temp[2] = MULT_13[state_[4*c]] ^ MULT_9[state_[4*c+1]] ^ MULT_14[state_[4*c+2]] ^ MULT_11[state_[4*c+3]];
-        temp[3] = MULT_11[state_[4*c]] ^ MULT_13[state_[4*c+1]] ^ MULT_9[state_[4*c+2]] ^ MULT_14[state_[4*c+3]];
-        state_[4*c] = temp[0]; state_[4*c+1] = temp[1]; state_[4*c+2] = temp[2]; state_[4*c+3] = temp[3];
+        temp[0] = MULT_14[state[4*c]] ^ MULT_11[state[4*c+1]] ^ MULT_13[state[4*c+2]] ^ MULT_9[state[4*c+3]];
+        temp[1] = MULT_9[state[4*c]] ^ MULT_14[state[4*c+1]] ^ MULT_11[state[4*c+2]] ^ MULT_13[state[4*c+3]];
+        temp[2] = MULT_13[state[4*c]] ^ MULT_9[state[4*c+1]] ^ MULT_14[state[4*c+2]] ^ MULT_11[state[4*c+3]];
+        temp[3] = MULT_11[state[4*c]] ^ MULT_13[state[4*c+1]] ^ MULT_9[state[4*c+2]] ^ MULT_14[state[4*c+3]];
+        state[4*c] = temp[0]; state[4*c+1] = temp[1]; state[4*c+2] = temp[2]; state[4*c+3] = temp[3];
     }
 }
 
-void Rijndael::addRoundKey(size_t round) {
+void Rijndael::addRoundKey(State& state, size_t round) const {
     for (size_t i = 0; i < 4; ++i) {
         uint32_t keyWord = roundKeys_[round * 4 + i];
-        state_[4*i] ^= (keyWord >> 24) & 0xFF;
-        state_[4*i+1] ^= (keyWord >> 16) & 0xFF;
-        state_[4*i+2] ^= (keyWord >> 8) & 0xFF;
-        state_[4*i+3] ^= keyWord & 0xFF;
+        state[4*i] ^= (keyWord >> 24) & 0xFF;
+        state[4*i+1] ^= (keyWord >> 16) & 0xFF;
+        state[4*i+2] ^= (keyWord >> 8) & 0xFF;
+        state[4*i+3] ^= keyWord & 0xFF;
     }
 }
 
@@ -153,41 +153,43 @@ void Rijndael::keyExpansion(const Byte* key) {
 }
 
 void Rijndael::encryptBlock(const Byte* input, Byte* output) {
-    blockToState(input);
+    State state;
+    blockToState(input, state);
     
-    addRoundKey(0);
+    addRoundKey(state, 0);
     
     for (size_t round = 1; round < numRounds_; ++round) {
-        subBytes();
-        shiftRows();
-        mixColumns();
-        addRoundKey(round);
+        subBytes(state);
+        shiftRows(state);
+        mixColumns(state);
+        addRoundKey(state, round);
     }
     
-    subBytes();
-    shiftRows();
-    addRoundKey(numRounds_);
+    subBytes(state);
+    shiftRows(state);
+    addRoundKey(state, numRounds_);
     
-    stateToBlock(output);
+    stateToBlock(state, output);
 }
 
 void Rijndael::decryptBlock(const Byte* input, Byte* output) {
-    blockToState(input);
+    State state;
+    blockToState(input, state);
     
-    addRoundKey(numRounds_);
+    addRoundKey(state, numRounds_);
     
     for (size_t round = numRounds_ - 1; round > 0; --round) {
-        invShiftRows();
-        invSubBytes();
-        addRoundKey(round);
-        invMixColumns();
+        invShiftRows(state);
+        invSubBytes(state);
+        addRoundKey(state, round);
+        invMixColumns(state);
     }
     
-    invShiftRows();
-    invSubBytes();
-    addRoundKey(0);
+    invShiftRows(state);
+    invSubBytes(state);
+    addRoundKey(state, 0);
     
-    stateToBlock(output);
+    stateToBlock(state, output);
 }
 
 }
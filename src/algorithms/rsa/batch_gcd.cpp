@@ -0,0 +1,125 @@
+#include "../../../include/crypto/algorithms/rsa/batch_gcd.hpp"
+#include "../../../include/crypto/core/exceptions.hpp"
+#include "../../../include/crypto/io/async_processor.hpp"
+#include <fstream>
+#include <sstream>
+
+namespace crypto {
+namespace rsa {
+
+std::vector<std::vector<BigInteger>> BatchGCD::productTree(const std::vector<BigInteger>& moduli,
+                                                           ThreadPool& pool) {
+    std::vector<std::vector<BigInteger>> tree;
+    tree.push_back(moduli);
+    
+    while (tree.back().size() > 1) {
+        const std::vector<BigInteger>& level = tree.back();
+        std::vector<BigInteger> next((level.size() + 1) / 2);
+        
+        pool.parallelFor(next.size(), [&](size_t i) {
+            if (2 * i + 1 < level.size()) {
+                next[i] = level[2 * i] * level[2 * i + 1];
+            } else {
+                next[i] = level[2 * i];
+            }
+        });
+        tree.push_back(std::move(next));
+    }
+    
+    return tree;
+}
+
+std::vector<BigInteger> BatchGCD::remainderTree(const std::vector<std::vector<BigInteger>>& tree,
+                                                ThreadPool& pool) {
+    std::vector<BigInteger> remainders = tree.back();
+    
+    for (size_t depth = tree.size() - 1; depth > 0; --depth) {
+        const std::vector<BigInteger>& children = tree[depth - 1];
+        std::vector<BigInteger> next(children.size());
+        bool atRoot = depth == tree.size() - 1;
+        
+        pool.parallelFor(children.size(), [&](size_t i) {
+            const BigInteger& child = children[i];
+            if (atRoot) {
+                next[i] = child * (children[i ^ 1] % child);
+            } else {
+                next[i] = remainders[i / 2] % (child * child);
+            }
+        });
+        
+        remainders = std::move(next);
+    }
+    
+    return remainders;
+}
+
+std::vector<BigInteger> BatchGCD::computeGcds(const std::vector<BigInteger>& moduli) {
+    ThreadPool pool(std::max<size_t>(1, std::thread::hardware_concurrency()));
+    return computeGcds(moduli, pool);
+}
+
+std::vector<BigInteger> BatchGCD::computeGcds(const std::vector<BigInteger>& moduli, ThreadPool& pool) {
+    for (const BigInteger& n : moduli) {
+        if (n <= BigInteger(1)) {
+            throw CryptoException("BatchGCD: moduli must be greater than 1");
+        }
+    }
+    
+    std::vector<BigInteger> gcds(moduli.size(), BigInteger(1));
+    if (moduli.size() < 2) {
+        return gcds;
+    }
+    
+    std::vector<std::vector<BigInteger>> tree = productTree(moduli, pool);
+    std::vector<BigInteger> remainders = remainderTree(tree, pool);
+    
+    pool.parallelFor(moduli.size(), [&](size_t i) {
+        gcds[i] = BigInteger::gcd(remainders[i] / moduli[i], moduli[i]);
+    });
+    
+    return gcds;
+}
+
+std::vector<SharedFactor> BatchGCD::findSharedFactors(const std::vector<BigInteger>& moduli) {
+    ThreadPool pool(std::max<size_t>(1, std::thread::hardware_concurrency()));
+    return findSharedFactors(moduli, pool);
+}
+
+std::vector<SharedFactor> BatchGCD::findSharedFactors(const std::vector<BigInteger>& moduli,
+                                                      ThreadPool& pool) {
+    std::vector<BigInteger> gcds = computeGcds(moduli, pool);
+    
+    std::vector<SharedFactor> result;
+    for (size_t i = 0; i < moduli.size(); ++i) {
+        if (!gcds[i].isOne()) {
+            result.push_back({i, moduli[i], gcds[i]});
+        }
+    }
+    return result;
+}
+
+std::vector<BigInteger> BatchGCD::loadModuli(const std::string& path) {
+    std::ifstream input(path);
+    if (!input) {
+        throw CryptoException("BatchGCD: cannot open " + path);
+    }
+    
+    std::vector<BigInteger> moduli;
+    std::string line;
+    while (std::getline(input, line)) {
+        std::istringstream fields(line);
+        std::string modulus;
+        if (!(fields >> modulus) || modulus[0] == '#') {
+            continue;
+        }
+        moduli.push_back(BigInteger::fromHex(modulus));
+    }
+    return moduli;
+}
+
+std::vector<SharedFactor> BatchGCD::auditFile(const std::string& path, ThreadPool& pool) {
+    return findSharedFactors(loadModuli(path), pool);
+}
+
+}
+}
@@ -1,9 +1,11 @@
 #include "../../../include/crypto/algorithms/rsa/big_integer.hpp"
 #include "../../../include/crypto/core/exceptions.hpp"
+#include "../../../include/crypto/math/random.hpp"
 #include <algorithm>
 #include <climits>
+#include <cmath>
 #include <cstring>
-#include <random>
+#include <tuple>
 
 namespace crypto {
 namespace rsa {
@@ -80,6 +82,12 @@ size_t BigInteger::bitLength() const {
     return result;
 }
 
+bool BigInteger::testBit(size_t index) const {
+    size_t digit = index / 32;
+    if (digit >= digits_.size()) return false;
+    return (digits_[digit] >> (index % 32)) & 1;
+}
+
 bool BigInteger::operator==(const BigInteger& other) const {
     return negative_ == other.negative_ && digits_ == other.digits_;
 }
@@ -175,16 +183,18 @@ BigInteger& BigInteger::operator-=(const BigInteger& other) {
         const BigInteger& larger = (cmp < 0) ? other : *this;
         const BigInteger& smaller = (cmp < 0) ? *this : other;
         
-        digits_.clear();
+        std::vector<uint32_t> difference;
+        difference.reserve(larger.digits_.size());
         uint32_t borrow = 0;
         for (size_t i = 0; i < larger.digits_.size(); ++i) {
             uint64_t diff = static_cast<uint64_t>(larger.digits_[i]) -
                            (i < smaller.digits_.size() ? smaller.digits_[i] : 0) -
                            borrow;
             borrow = (diff >> 32) ? 1 : 0;
-            digits_.push_back(static_cast<uint32_t>(diff & 0xFFFFFFFF));
+            difference.push_back(static_cast<uint32_t>(diff & 0xFFFFFFFF));
         }
         
+        digits_ = std::move(difference);
         negative_ = resultNegative;
         normalize();
     }
@@ -192,29 +202,110 @@ BigInteger& BigInteger::operator-=(const BigInteger& other) {
     return *this;
 }
 
-BigInteger BigInteger::operator*(const BigInteger& other) const {
-    BigInteger result(0);
-    
-    for (size_t i = 0; i < digits_.size(); ++i) {
-        BigInteger temp(0);
-        temp.digits_.resize(i + other.digits_.size(), 0);
-        
+static constexpr size_t KARATSUBA_THRESHOLD = 32;
+static constexpr size_t NEWTON_DIVISION_THRESHOLD = 64;
+
+static void multiplySchool(const uint32_t* a, size_t na, const uint32_t* b, size_t nb, uint32_t* out) {
+    std::fill(out, out + na + nb, 0u);
+    for (size_t i = 0; i < na; ++i) {
         uint64_t carry = 0;
-        for (size_t j = 0; j < other.digits_.size(); ++j) {
-            uint64_t product = static_cast<uint64_t>(digits_[i]) * other.digits_[j] + carry;
-            temp.digits_[i + j] = static_cast<uint32_t>(product & 0xFFFFFFFF);
+        uint64_t ai = a[i];
+        for (size_t j = 0; j < nb; ++j) {
+            uint64_t product = ai * b[j] + out[i + j] + carry;
+            out[i + j] = static_cast<uint32_t>(product);
             carry = product >> 32;
         }
-        
-        if (carry > 0) {
-            temp.digits_.push_back(static_cast<uint32_t>(carry));
-        }
-        
-        temp.negative_ = false;
-        temp.normalize();
-        result += temp;
+        out[i + nb] = static_cast<uint32_t>(carry);
+    }
+}
+
+static void addLimbs(uint32_t* out, size_t outLength, const uint32_t* a, size_t na) {
+    uint64_t carry = 0;
+    size_t i = 0;
+    for (; i < na; ++i) {
+        uint64_t sum = static_cast<uint64_t>(out[i]) + a[i] + carry;
+        out[i] = static_cast<uint32_t>(sum);
+        carry = sum >> 32;
+    }
+    for (; carry != 0 && i < outLength; ++i) {
+        uint64_t sum = static_cast<uint64_t>(out[i]) + carry;
+        out[i] = static_cast<uint32_t>(sum);
+        carry = sum >> 32;
+    }
+}
+
+static void subtractLimbs(uint32_t* out, size_t outLength, const uint32_t* a, size_t na) {
+    uint64_t borrow = 0;
+    size_t i = 0;
+    for (; i < na; ++i) {
+        uint64_t diff = static_cast<uint64_t>(out[i]) - a[i] - borrow;
+        out[i] = static_cast<uint32_t>(diff);
+        borrow = (diff >> 32) & 1;
+    }
+    for (; borrow != 0 && i < outLength; ++i) {
+        uint64_t diff = static_cast<uint64_t>(out[i]) - borrow;
+        out[i] = static_cast<uint32_t>(diff);
+        borrow = (diff >> 32) & 1;
     }
+}
+
+static void multiplyKaratsuba(const uint32_t* a, const uint32_t* b, size_t n, uint32_t* out) {
+    if (n < KARATSUBA_THRESHOLD) {
+        multiplySchool(a, n, b, n, out);
+        return;
+    }
+    
+    size_t low = n / 2;
+    size_t high = n - low;
+    
+    std::vector<uint32_t> sumA(high + 1, 0), sumB(high + 1, 0), middle(2 * (high + 1));
+    std::copy(a + low, a + n, sumA.begin());
+    addLimbs(sumA.data(), high + 1, a, low);
+    std::copy(b + low, b + n, sumB.begin());
+    addLimbs(sumB.data(), high + 1, b, low);
+    
+    multiplyKaratsuba(sumA.data(), sumB.data(), high + 1, middle.data());
+    multiplyKaratsuba(a, b, low, out);
+    multiplyKaratsuba(a + low, b + low, high, out + 2 * low);
+    
+    subtractLimbs(middle.data(), middle.size(), out, 2 * low);
+    subtractLimbs(middle.data(), middle.size(), out + 2 * low, 2 * high);
+    
+    size_t middleLength = middle.size();
+    while (middleLength > 0 && middle[middleLength - 1] == 0) {
+        middleLength--;
+    }
+    addLimbs(out + low, 2 * n - low, middle.data(), middleLength);
+}
+
+std::vector<uint32_t> BigInteger::multiplyDigits(const std::vector<uint32_t>& a,
+                                                 const std::vector<uint32_t>& b) {
+    const std::vector<uint32_t>& longer = a.size() >= b.size() ? a : b;
+    const std::vector<uint32_t>& shorter = a.size() >= b.size() ? b : a;
+    size_t nl = longer.size();
+    size_t ns = shorter.size();
     
+    std::vector<uint32_t> result(nl + ns, 0);
+    if (ns < KARATSUBA_THRESHOLD) {
+        multiplySchool(longer.data(), nl, shorter.data(), ns, result.data());
+        return result;
+    }
+    
+    std::vector<uint32_t> chunk(ns), product(2 * ns);
+    for (size_t offset = 0; offset < nl; offset += ns) {
+        size_t length = std::min(ns, nl - offset);
+        std::fill(chunk.begin(), chunk.end(), 0u);
+        std::copy(longer.begin() + offset, longer.begin() + offset + length, chunk.begin());
+        multiplyKaratsuba(chunk.data(), shorter.data(), ns, product.data());
+        addLimbs(result.data() + offset, result.size() - offset, product.data(),
+                 std::min(product.size(), result.size() - offset));
+    }
+    return result;
+}
+
+BigInteger BigInteger::operator*(const BigInteger& other) const {
+    BigInteger result;
+    result.digits_ = multiplyDigits(digits_, other.digits_);
     result.negative_ = negative_ != other.negative_;
     result.normalize();
     return result;
@@ -237,23 +328,20 @@ std::pair<BigInteger, BigInteger> BigInteger::divideWithRemainder(
         throw CryptoException("Division by zero");
     }
     
-    BigInteger quotient(0);
-    BigInteger remainder = dividend;
-    remainder.negative_ = false;
-    BigInteger div = divisor;
-    div.negative_ = false;
+    BigInteger numerator = dividend;
+    numerator.negative_ = false;
+    BigInteger denominator = divisor;
+    denominator.negative_ = false;
     
-    while (remainder >= div) {
-        BigInteger temp = div;
-        BigInteger multiplier(1);
-        
-        while ((temp << 1) <= remainder) {
-            temp = temp << 1;
-            multiplier = multiplier << 1;
-        }
-        
-        remainder -= temp;
-        quotient += multiplier;
+    BigInteger quotient;
+    BigInteger remainder;
+    if (numerator.compareAbsolute(denominator) < 0) {
+        remainder = numerator;
+    } else if (denominator.digits_.size() >= NEWTON_DIVISION_THRESHOLD &&
+               numerator.digits_.size() - denominator.digits_.size() >= NEWTON_DIVISION_THRESHOLD) {
+        std::tie(quotient, remainder) = divideNewton(numerator, denominator);
+    } else {
+        std::tie(quotient, remainder) = divideKnuth(numerator, denominator);
     }
     
     quotient.negative_ = dividend.negative_ != divisor.negative_;
@@ -265,6 +353,156 @@ std::pair<BigInteger, BigInteger> BigInteger::divideWithRemainder(
     return {quotient, remainder};
 }
 
+std::pair<BigInteger, BigInteger> BigInteger::divideKnuth(
+    const BigInteger& dividend, const BigInteger& divisor) {
+    
+    const std::vector<uint32_t>& u = dividend.digits_;
+    const std::vector<uint32_t>& v = divisor.digits_;
+    size_t m = u.size();
+    size_t n = v.size();
+    
+    BigInteger quotient;
+    BigInteger remainder;
+    quotient.digits_.assign(m - n + 1, 0);
+    
+    if (n == 1) {
+        uint64_t rest = 0;
+        for (size_t i = m; i > 0; --i) {
+            uint64_t value = (rest << 32) | u[i - 1];
+            quotient.digits_[i - 1] = static_cast<uint32_t>(value / v[0]);
+            rest = value % v[0];
+        }
+        remainder.digits_[0] = static_cast<uint32_t>(rest);
+        quotient.normalize();
+        return {quotient, remainder};
+    }
+    
+    int shift = __builtin_clz(v[n - 1]);
+    std::vector<uint32_t> vn(n), un(m + 1);
+    for (size_t i = n - 1; i > 0; --i) {
+        vn[i] = (v[i] << shift) | (shift ? static_cast<uint32_t>(static_cast<uint64_t>(v[i - 1]) >> (32 - shift)) : 0);
+    }
+    vn[0] = v[0] << shift;
+    un[m] = shift ? static_cast<uint32_t>(static_cast<uint64_t>(u[m - 1]) >> (32 - shift)) : 0;
+    for (size_t i = m - 1; i > 0; --i) {
+        un[i] = (u[i] << shift) | (shift ? static_cast<uint32_t>(static_cast<uint64_t>(u[i - 1]) >> (32 - shift)) : 0);
+    }
+    un[0] = u[0] << shift;
+    
+    const uint64_t base = 1ULL << 32;
+    for (size_t j = m - n + 1; j > 0; --j) {
+        size_t k = j - 1;
+        uint64_t numerator = (static_cast<uint64_t>(un[k + n]) << 32) | un[k + n - 1];
+        uint64_t qhat = numerator / vn[n - 1];
+        uint64_t rhat = numerator % vn[n - 1];
+        while (qhat >= base || qhat * vn[n - 2] > ((rhat << 32) | un[k + n - 2])) {
+            qhat--;
+            rhat += vn[n - 1];
+            if (rhat >= base) {
+                break;
+            }
+        }
+        
+        int64_t borrow = 0;
+        int64_t t = 0;
+        for (size_t i = 0; i < n; ++i) {
+            uint64_t product = qhat * vn[i];
+            t = static_cast<int64_t>(un[i + k]) - borrow - static_cast<int64_t>(product & 0xFFFFFFFF);
+            un[i + k] = static_cast<uint32_t>(t);
+            borrow = static_cast<int64_t>(product >> 32) - (t >> 32);
+        }
+        t = static_cast<int64_t>(un[k + n]) - borrow;
+        un[k + n] = static_cast<uint32_t>(t);
+        
+        if (t < 0) {
+            qhat--;
+            uint64_t carry = 0;
+            for (size_t i = 0; i < n; ++i) {
+                uint64_t sum = static_cast<uint64_t>(un[i + k]) + vn[i] + carry;
+                un[i + k] = static_cast<uint32_t>(sum);
+                carry = sum >> 32;
+            }
+            un[k + n] = static_cast<uint32_t>(un[k + n] + carry);
+        }
+        quotient.digits_[k] = static_cast<uint32_t>(qhat);
+    }
+    
+    remainder.digits_.resize(n);
+    for (size_t i = 0; i < n; ++i) {
+        remainder.digits_[i] = (un[i] >> shift) |
+            (shift ? static_cast<uint32_t>(static_cast<uint64_t>(un[i + 1]) << (32 - shift)) : 0);
+    }
+    quotient.normalize();
+    remainder.normalize();
+    return {quotient, remainder};
+}
+
+BigInteger BigInteger::reciprocal(const BigInteger& divisor) {
+    size_t n = divisor.digits_.size();
+    BigInteger power = BigInteger(1) << (64 * n);
+    if (n < NEWTON_DIVISION_THRESHOLD) {
+        return divideKnuth(power, divisor).first;
+    }
+    
+    size_t k = n / 2 + 1;
+    size_t low = n - k;
+    BigInteger top = reciprocal(divisor >> (32 * low));
+    BigInteger error = power - ((divisor * top) << (32 * low));
+    BigInteger delta = (top * (error >> (32 * (n - 2)))) >> (32 * (k + 2));
+    
+    BigInteger x = (top << (32 * low)) + delta;
+    BigInteger rest = error - divisor * delta;
+    BigInteger one(1);
+    while (rest.sign() < 0) {
+        x -= one;
+        rest += divisor;
+    }
+    while (rest >= divisor) {
+        x += one;
+        rest -= divisor;
+    }
+    return x;
+}
+
+std::pair<BigInteger, BigInteger> BigInteger::divideNewton(
+    const BigInteger& numerator, const BigInteger& denominator) {
+    
+    int shift = __builtin_clz(denominator.digits_.back());
+    BigInteger dividend = numerator << shift;
+    BigInteger divisor = denominator << shift;
+    
+    size_t n = divisor.digits_.size();
+    size_t m = dividend.digits_.size();
+    BigInteger inverse = reciprocal(divisor);
+    BigInteger one(1);
+    
+    BigInteger quotient;
+    BigInteger remainder;
+    size_t chunks = (m + n - 1) / n;
+    for (size_t c = chunks; c > 0; --c) {
+        size_t begin = (c - 1) * n;
+        size_t end = std::min(begin + n, m);
+        
+        BigInteger chunk;
+        chunk.digits_.assign(dividend.digits_.begin() + begin, dividend.digits_.begin() + end);
+        chunk.normalize();
+        
+        BigInteger current = (remainder << (32 * n)) + chunk;
+        BigInteger q = ((current >> (32 * (n - 1))) * inverse) >> (32 * (n + 1));
+        remainder = current - q * divisor;
+        while (remainder.sign() < 0) {
+            q -= one;
+            remainder += divisor;
+        }
+        while (remainder >= divisor) {
+            q += one;
+            remainder -= divisor;
+        }
+        quotient = (quotient << (32 * n)) + q;
+    }
+    return {quotient, remainder >> shift};
+}
+
 BigInteger BigInteger::operator<<(size_t shift) const {
     BigInteger result = *this;
     
@@ -335,6 +573,18 @@ BigInteger BigInteger::modPow(const BigInteger& base, const BigInteger& exp, con
     return result;
 }
 
+uint32_t BigInteger::modSmall(uint32_t divisor) const {
+    if (divisor == 0) {
+        throw CryptoException("Division by zero");
+    }
+    
+    uint64_t remainder = 0;
+    for (size_t i = digits_.size(); i > 0; --i) {
+        remainder = ((remainder << 32) | digits_[i - 1]) % divisor;
+    }
+    return static_cast<uint32_t>(remainder);
+}
+
 BigInteger BigInteger::gcd(const BigInteger& a, const BigInteger& b) {
     BigInteger x = a;
     BigInteger y = b;
@@ -350,6 +600,187 @@ BigInteger BigInteger::gcd(const BigInteger& a, const BigInteger& b) {
     return x;
 }
 
+static uint64_t isqrtSmall(uint64_t n) {
+    uint64_t root = static_cast<uint64_t>(std::sqrt(static_cast<double>(n)));
+    while (root > 0 && (root > UINT32_MAX || root * root > n)) {
+        root--;
+    }
+    while (root < UINT32_MAX && (root + 1) * (root + 1) <= n) {
+        root++;
+    }
+    return root;
+}
+
+BigInteger BigInteger::isqrt(const BigInteger& n) {
+    if (n.negative_) {
+        throw CryptoException("Square root of negative number");
+    }
+    
+    size_t bits = n.bitLength();
+    if (bits <= 64) {
+        uint64_t value = n.digits_[0];
+        if (n.digits_.size() > 1) {
+            value |= static_cast<uint64_t>(n.digits_[1]) << 32;
+        }
+        return BigInteger(static_cast<int64_t>(isqrtSmall(value)));
+    }
+    
+    size_t shift = (bits - 63) & ~static_cast<size_t>(1);
+    BigInteger top = n >> shift;
+    uint64_t topValue = top.digits_[0] | (static_cast<uint64_t>(top.digits_[1]) << 32);
+    BigInteger x = BigInteger(static_cast<int64_t>(isqrtSmall(topValue) + 1)) << (shift / 2);
+    
+    while (true) {
+        BigInteger y = (x + n / x) >> 1;
+        if (y >= x) {
+            return x;
+        }
+        x = y;
+    }
+}
+
+BigInteger BigInteger::pow(const BigInteger& base, uint32_t exp) {
+    BigInteger result(1);
+    BigInteger square = base;
+    while (exp != 0) {
+        if (exp & 1) {
+            result = result * square;
+        }
+        exp >>= 1;
+        if (exp != 0) {
+            square = square * square;
+        }
+    }
+    return result;
+}
+
+BigInteger BigInteger::iroot(const BigInteger& n, uint32_t k) {
+    if (k == 0) {
+        throw CryptoException("Zeroth root is undefined");
+    }
+    if (n.negative_) {
+        throw CryptoException("Root of negative number");
+    }
+    if (k == 1 || n.isZero()) {
+        return n;
+    }
+    if (k == 2) {
+        return isqrt(n);
+    }
+    
+    size_t bits = n.bitLength();
+    if (bits <= k) {
+        return BigInteger(1);
+    }
+    
+    BigInteger degree(static_cast<int64_t>(k));
+    BigInteger lower(static_cast<int64_t>(k - 1));
+    BigInteger x = BigInteger(1) << ((bits + k - 1) / k);
+    while (true) {
+        BigInteger y = (lower * x + n / pow(x, k - 1)) / degree;
+        if (y >= x) {
+            return x;
+        }
+        x = y;
+    }
+}
+
+namespace {
+
+struct SquareResidues {
+    bool mod64[64] = {};
+    bool mod63[63] = {};
+    bool mod65[65] = {};
+    bool mod11[11] = {};
+    
+    SquareResidues() {
+        for (uint32_t i = 0; i < 64; ++i) {
+            mod64[i * i % 64] = true;
+            mod63[i * i % 63] = true;
+            mod65[i * i % 65] = true;
+            mod11[i * i % 11] = true;
+        }
+    }
+};
+
+const SquareResidues& squareResidues() {
+    static const SquareResidues residues;
+    return residues;
+}
+
+}
+
+bool BigInteger::isPerfectSquare(const BigInteger& n) {
+    BigInteger root;
+    return isPerfectSquare(n, root);
+}
+
+bool BigInteger::isPerfectSquare(const BigInteger& n, BigInteger& root) {
+    if (n.negative_) {
+        return false;
+    }
+    
+    const SquareResidues& residues = squareResidues();
+    if (!residues.mod64[n.digits_[0] & 63]) {
+        return false;
+    }
+    uint32_t r = n.modSmall(63 * 65 * 11);
+    if (!residues.mod63[r % 63] || !residues.mod65[r % 65] || !residues.mod11[r % 11]) {
+        return false;
+    }
+    
+    root = isqrt(n);
+    return root * root == n;
+}
+
+bool BigInteger::isPerfectPower(const BigInteger& n, BigInteger& root, uint32_t& exponent) {
+    if (n.negative_ || n <= BigInteger(1)) {
+        return false;
+    }
+    
+    if (isPerfectSquare(n, root)) {
+        exponent = 2;
+        BigInteger inner;
+        uint32_t innerExponent;
+        if (isPerfectPower(root, inner, innerExponent)) {
+            root = inner;
+            exponent *= innerExponent;
+        }
+        return true;
+    }
+    
+    size_t bits = n.bitLength();
+    for (uint32_t k = 3; k < bits; k += 2) {
+        bool prime = true;
+        for (uint32_t f = 3; f * f <= k; f += 2) {
+            if (k % f == 0) {
+                prime = false;
+                break;
+            }
+        }
+        if (!prime) {
+            continue;
+        }
+        
+        BigInteger candidate = iroot(n, k);
+        if (candidate.isOne()) {
+            break;
+        }
+        if (pow(candidate, k) == n) {
+            BigInteger inner;
+            uint32_t innerExponent;
+            root = candidate;
+            exponent = k;
+            if (isPerfectPower(candidate, inner, innerExponent)) {
+                root = inner;
+                exponent *= innerExponent;
+            }
+            return true;
+        }
+    }
+    return false;
+}
+
 BigInteger BigInteger::modInv(const BigInteger& a, const BigInteger& m) {
     BigInteger x0(0), x1(1);
     BigInteger a_copy = a;
@@ -452,23 +883,19 @@ BigInteger BigInteger::fromHex(const std::string& hex) {
 }
 
 BigInteger BigInteger::random(size_t bits) {
-    std::random_device rd;
-    std::mt19937 gen(rd());
-    std::uniform_int_distribution<uint32_t> dis;
-    
     BigInteger result(0);
     size_t fullDigits = bits / 32;
     size_t remainingBits = bits % 32;
     
     result.digits_.resize(fullDigits + (remainingBits > 0 ? 1 : 0));
-    
-    for (size_t i = 0; i < fullDigits; ++i) {
-        result.digits_[i] = dis(gen);
+    if (!result.digits_.empty()) {
+        math::SecureRandom::fill(reinterpret_cast<Byte*>(result.digits_.data()),
+                                 result.digits_.size() * sizeof(uint32_t));
     }
     
     if (remainingBits > 0) {
         uint32_t mask = (1ULL << remainingBits) - 1;
-        result.digits_[fullDigits] = dis(gen) & mask;
+        result.digits_[fullDigits] &= mask;
         if (result.digits_[fullDigits] == 0 && bits > 0) {
             result.digits_[fullDigits] = 1;
         }
@@ -0,0 +1,41 @@
+#include "../../../include/crypto/algorithms/rsa/convergent_generator.hpp"
+#include "../../../include/crypto/core/exceptions.hpp"
+
+namespace crypto {
+namespace rsa {
+
+ConvergentGenerator::ConvergentGenerator(const BigInteger& numerator, const BigInteger& denominator)
+    : remainderNumerator_(numerator)
+    , remainderDenominator_(denominator)
+    , h_(1), hPrev_(0)
+    , k_(0), kPrev_(1)
+    , terms_(0) {
+    
+    if (denominator.sign() <= 0 || numerator.sign() < 0) {
+        throw CryptoException("Continued fraction requires a non-negative numerator and positive denominator");
+    }
+}
+
+bool ConvergentGenerator::next() {
+    if (remainderDenominator_.isZero()) {
+        return false;
+    }
+    
+    term_ = remainderNumerator_ / remainderDenominator_;
+    BigInteger remainder = remainderNumerator_ - term_ * remainderDenominator_;
+    remainderNumerator_ = remainderDenominator_;
+    remainderDenominator_ = remainder;
+    
+    BigInteger h = term_ * h_ + hPrev_;
+    BigInteger k = term_ * k_ + kPrev_;
+    hPrev_ = h_;
+    kPrev_ = k_;
+    h_ = h;
+    k_ = k;
+    
+    terms_++;
+    return true;
+}
+
+}
+}
@@ -0,0 +1,88 @@
+#include "../../../include/crypto/algorithms/rsa/fermat_factorizer.hpp"
+#include "../../../include/crypto/io/async_processor.hpp"
+
+namespace crypto {
+namespace rsa {
+
+void FermatFactorizer::searchStride(Search& search, size_t offset) {
+    if (offset >= search.maxSteps) {
+        return;
+    }
+    
+    BigInteger stride(static_cast<int64_t>(search.stride));
+    BigInteger a = search.start + BigInteger(static_cast<int64_t>(offset));
+    BigInteger b2 = a * a - search.n;
+    BigInteger delta = ((a * stride) << 1) + stride * stride;
+    BigInteger increment = (stride * stride) << 1;
+    BigInteger b;
+    
+    for (size_t step = offset; step < search.maxSteps; step += search.stride) {
+        if (step > search.best.load(std::memory_order_relaxed)) {
+            return;
+        }
+        
+        if (BigInteger::isPerfectSquare(b2, b)) {
+            std::lock_guard<std::mutex> lock(search.mutex);
+            if (step < search.best.load(std::memory_order_relaxed)) {
+                search.best.store(step, std::memory_order_relaxed);
+                search.a = search.start + BigInteger(static_cast<int64_t>(step));
+                search.b = b;
+            }
+            return;
+        }
+        b2 += delta;
+        delta += increment;
+    }
+}
+
+bool FermatFactorizer::run(const BigInteger& n, BigInteger& p, BigInteger& q, size_t maxSteps,
+                           ThreadPool* pool) {
+    if (n <= BigInteger(1) || n.isEven()) {
+        return false;
+    }
+    
+    Search search;
+    search.start = BigInteger::isqrt(n);
+    if (search.start * search.start == n) {
+        p = search.start;
+        q = search.start;
+        return true;
+    }
+    
+    search.n = n;
+    search.start += BigInteger(1);
+    search.maxSteps = maxSteps;
+    search.stride = pool ? pool->size() + 1 : 1;
+    search.best = maxSteps;
+    
+    if (pool) {
+        pool->parallelFor(search.stride, [&](size_t offset) {
+            searchStride(search, offset);
+        });
+    } else {
+        searchStride(search, 0);
+    }
+    
+    if (search.best.load() == maxSteps) {
+        return false;
+    }
+    BigInteger smaller = search.a - search.b;
+    if (smaller.isOne()) {
+        return false;
+    }
+    p = search.a + search.b;
+    q = smaller;
+    return true;
+}
+
+bool FermatFactorizer::factor(const BigInteger& n, BigInteger& p, BigInteger& q, size_t maxSteps) {
+    return run(n, p, q, maxSteps, nullptr);
+}
+
+bool FermatFactorizer::factor(const BigInteger& n, BigInteger& p, BigInteger& q, size_t maxSteps,
+                              ThreadPool& pool) {
+    return run(n, p, q, maxSteps, &pool);
+}
+
+}
+}
@@ -0,0 +1,321 @@
+#include "../../../include/crypto/algorithms/rsa/montgomery.hpp"
+#include "../../../include/crypto/core/exceptions.hpp"
+#include <algorithm>
+
+namespace crypto {
+namespace rsa {
+
+ExponentWindows ExponentWindows::build(const BigInteger& exponent) {
+    ExponentWindows result;
+    if (exponent.sign() <= 0) {
+        return result;
+    }
+
+    size_t bits = exponent.bitLength();
+    if (bits > 512) {
+        result.width = 5;
+    } else if (bits > 128) {
+        result.width = 4;
+    } else if (bits > 24) {
+        result.width = 3;
+    } else if (bits > 8) {
+        result.width = 2;
+    } else {
+        result.width = 1;
+    }
+
+    uint32_t pending = 0;
+    size_t i = bits;
+    while (i > 0) {
+        size_t top = i - 1;
+        if (!exponent.testBit(top)) {
+            pending++;
+            i--;
+            continue;
+        }
+
+        size_t low = top + 1 >= result.width ? top + 1 - result.width : 0;
+        while (!exponent.testBit(low)) {
+            low++;
+        }
+
+        uint32_t value = 0;
+        for (size_t bit = top + 1; bit > low; --bit) {
+            value = (value << 1) | (exponent.testBit(bit - 1) ? 1u : 0u);
+        }
+
+        uint32_t length = static_cast<uint32_t>(top - low + 1);
+        result.steps.push_back({pending + length, value});
+        pending = 0;
+        i = low;
+    }
+
+    if (pending > 0) {
+        result.steps.push_back({pending, 0});
+    }
+
+    return result;
+}
+
+MontgomeryContext::MontgomeryContext(const BigInteger& modulus) : modulus_(modulus) {
+    if (modulus.sign() <= 0 || modulus.isEven()) {
+        throw CryptoException("Montgomery modulus must be positive and odd");
+    }
+
+    n_ = modulus.digits_;
+    size_t k = n_.size();
+
+    uint32_t inv = n_[0];
+    for (int i = 0; i < 5; ++i) {
+        inv *= 2 - n_[0] * inv;
+    }
+    nPrime_ = 0u - inv;
+
+    std::vector<uint32_t> x(k, 0);
+    x[0] = 1;
+    if (k == 1 && n_[0] == 1) {
+        x[0] = 0;
+    }
+
+    for (size_t step = 0; step < 64 * k; ++step) {
+        uint32_t carry = 0;
+        for (size_t j = 0; j < k; ++j) {
+            uint32_t next = x[j] >> 31;
+            x[j] = (x[j] << 1) | carry;
+            carry = next;
+        }
+        if (geModulus(x.data(), carry)) {
+            subtractModulus(x.data());
+        }
+        if (step + 1 == 32 * k) {
+            one_ = x;
+        }
+    }
+    r2_ = x;
+}
+
+bool MontgomeryContext::geModulus(const uint32_t* a, uint32_t carry) const {
+    if (carry != 0) return true;
+    for (size_t j = n_.size(); j > 0; --j) {
+        if (a[j - 1] != n_[j - 1]) {
+            return a[j - 1] > n_[j - 1];
+        }
+    }
+    return true;
+}
+
+void MontgomeryContext::subtractModulus(uint32_t* a) const {
+    uint64_t borrow = 0;
+    for (size_t j = 0; j < n_.size(); ++j) {
+        uint64_t diff = static_cast<uint64_t>(a[j]) - n_[j] - borrow;
+        a[j] = static_cast<uint32_t>(diff);
+        borrow = (diff >> 32) & 1;
+    }
+}
+
+void MontgomeryContext::add(const uint32_t* a, const uint32_t* b, uint32_t* out) const {
+    uint64_t carry = 0;
+    for (size_t j = 0; j < n_.size(); ++j) {
+        uint64_t sum = static_cast<uint64_t>(a[j]) + b[j] + carry;
+        out[j] = static_cast<uint32_t>(sum);
+        carry = sum >> 32;
+    }
+    if (geModulus(out, static_cast<uint32_t>(carry))) {
+        subtractModulus(out);
+    }
+}
+
+void MontgomeryContext::sub(const uint32_t* a, const uint32_t* b, uint32_t* out) const {
+    uint64_t borrow = 0;
+    for (size_t j = 0; j < n_.size(); ++j) {
+        uint64_t diff = static_cast<uint64_t>(a[j]) - b[j] - borrow;
+        out[j] = static_cast<uint32_t>(diff);
+        borrow = (diff >> 32) & 1;
+    }
+    if (borrow != 0) {
+        uint64_t carry = 0;
+        for (size_t j = 0; j < n_.size(); ++j) {
+            uint64_t sum = static_cast<uint64_t>(out[j]) + n_[j] + carry;
+            out[j] = static_cast<uint32_t>(sum);
+            carry = sum >> 32;
+        }
+    }
+}
+
+void MontgomeryContext::halve(uint32_t* a) const {
+    size_t k = n_.size();
+    uint32_t top = 0;
+    if (a[0] & 1) {
+        uint64_t carry = 0;
+        for (size_t j = 0; j < k; ++j) {
+            uint64_t sum = static_cast<uint64_t>(a[j]) + n_[j] + carry;
+            a[j] = static_cast<uint32_t>(sum);
+            carry = sum >> 32;
+        }
+        top = static_cast<uint32_t>(carry);
+    }
+    for (size_t j = 0; j < k; ++j) {
+        uint32_t high = j + 1 < k ? a[j + 1] : top;
+        a[j] = (a[j] >> 1) | (high << 31);
+    }
+}
+
+bool MontgomeryContext::isZero(const uint32_t* a) const {
+    return std::all_of(a, a + n_.size(), [](uint32_t limb) { return limb == 0; });
+}
+
+void MontgomeryContext::mul(const uint32_t* a, const uint32_t* b,
+                            uint32_t* out, uint32_t* scratch) const {
+    size_t k = n_.size();
+    uint32_t* t = scratch;
+    std::fill(t, t + k + 2, 0u);
+
+    for (size_t i = 0; i < k; ++i) {
+        uint64_t carry = 0;
+        uint64_t bi = b[i];
+        for (size_t j = 0; j < k; ++j) {
+            uint64_t product = static_cast<uint64_t>(a[j]) * bi + t[j] + carry;
+            t[j] = static_cast<uint32_t>(product);
+            carry = product >> 32;
+        }
+        uint64_t sum = static_cast<uint64_t>(t[k]) + carry;
+        t[k] = static_cast<uint32_t>(sum);
+        t[k + 1] = static_cast<uint32_t>(sum >> 32);
+
+        uint64_t m = static_cast<uint32_t>(t[0] * nPrime_);
+        uint64_t product = m * n_[0] + t[0];
+        carry = product >> 32;
+        for (size_t j = 1; j < k; ++j) {
+            product = m * n_[j] + t[j] + carry;
+            t[j - 1] = static_cast<uint32_t>(product);
+            carry = product >> 32;
+        }
+        sum = static_cast<uint64_t>(t[k]) + carry;
+        t[k - 1] = static_cast<uint32_t>(sum);
+        t[k] = t[k + 1] + static_cast<uint32_t>(sum >> 32);
+    }
+
+    if (geModulus(t, t[k])) {
+        subtractModulus(t);
+    }
+    std::copy(t, t + k, out);
+}
+
+void MontgomeryContext::toLimbs(const BigInteger& a, uint32_t* out) const {
+    size_t k = n_.size();
+    if (a.digits_.size() > k) {
+        throw CryptoException("Montgomery operand is wider than modulus");
+    }
+    std::fill(out, out + k, 0u);
+    std::copy(a.digits_.begin(), a.digits_.end(), out);
+}
+
+BigInteger MontgomeryContext::fromLimbs(const uint32_t* a) const {
+    BigInteger result;
+    result.digits_.assign(a, a + n_.size());
+    result.negative_ = false;
+    result.normalize();
+    return result;
+}
+
+BigInteger MontgomeryContext::toMontgomery(const BigInteger& a) const {
+    size_t k = n_.size();
+    std::vector<uint32_t> acc(k, 0), chunk(k), term(k), scratch(k + 2);
+
+    const std::vector<uint32_t>& digits = a.digits_;
+    size_t chunks = (digits.size() + k - 1) / k;
+    for (size_t c = chunks; c > 0; --c) {
+        size_t begin = (c - 1) * k;
+        size_t end = std::min(begin + k, digits.size());
+        std::fill(chunk.begin(), chunk.end(), 0u);
+        std::copy(digits.begin() + begin, digits.begin() + end, chunk.begin());
+
+        mul(acc.data(), r2_.data(), acc.data(), scratch.data());
+        mul(chunk.data(), r2_.data(), term.data(), scratch.data());
+        add(acc.data(), term.data(), acc.data());
+    }
+
+    BigInteger result = fromLimbs(acc.data());
+    if (a.negative_ && !result.isZero()) {
+        result = modulus_ - result;
+    }
+    return result;
+}
+
+BigInteger MontgomeryContext::fromMontgomery(const BigInteger& a) const {
+    size_t k = n_.size();
+    std::vector<uint32_t> x(k), unit(k, 0), scratch(k + 2);
+    toLimbs(a, x.data());
+    unit[0] = 1;
+    mul(x.data(), unit.data(), x.data(), scratch.data());
+    return fromLimbs(x.data());
+}
+
+BigInteger MontgomeryContext::reduce(const BigInteger& a) const {
+    return fromMontgomery(toMontgomery(a));
+}
+
+BigInteger MontgomeryContext::multiply(const BigInteger& a, const BigInteger& b) const {
+    size_t k = n_.size();
+    std::vector<uint32_t> x(k), y(k), scratch(k + 2);
+    toLimbs(a, x.data());
+    toLimbs(b, y.data());
+    mul(x.data(), y.data(), x.data(), scratch.data());
+    return fromLimbs(x.data());
+}
+
+BigInteger MontgomeryContext::one() const {
+    return fromLimbs(one_.data());
+}
+
+void MontgomeryContext::powLimbs(const uint32_t* baseMont, const ExponentWindows& exp,
+                                 uint32_t* out) const {
+    size_t k = n_.size();
+    if (exp.isZero()) {
+        std::copy(one_.begin(), one_.end(), out);
+        return;
+    }
+
+    size_t tableSize = size_t(1) << (exp.width - 1);
+    std::vector<uint32_t> table(tableSize * k), square(k), scratch(k + 2);
+    std::copy(baseMont, baseMont + k, table.begin());
+    if (tableSize > 1) {
+        mul(baseMont, baseMont, square.data(), scratch.data());
+        for (size_t i = 1; i < tableSize; ++i) {
+            mul(&table[(i - 1) * k], square.data(), &table[i * k], scratch.data());
+        }
+    }
+
+    bool started = false;
+    for (const ExponentWindows::Step& step : exp.steps) {
+        if (!started) {
+            const uint32_t* entry = &table[(step.oddValue >> 1) * k];
+            std::copy(entry, entry + k, out);
+            started = true;
+            continue;
+        }
+        for (uint32_t s = 0; s < step.squarings; ++s) {
+            mul(out, out, out, scratch.data());
+        }
+        if (step.oddValue != 0) {
+            mul(out, &table[(step.oddValue >> 1) * k], out, scratch.data());
+        }
+    }
+}
+
+BigInteger MontgomeryContext::modPow(const BigInteger& base, const ExponentWindows& exp) const {
+    size_t k = n_.size();
+    std::vector<uint32_t> x(k), result(k), unit(k, 0), scratch(k + 2);
+    toLimbs(toMontgomery(base), x.data());
+    powLimbs(x.data(), exp, result.data());
+    unit[0] = 1;
+    mul(result.data(), unit.data(), result.data(), scratch.data());
+    return fromLimbs(result.data());
+}
+
+BigInteger MontgomeryContext::modPow(const BigInteger& base, const BigInteger& exp) const {
+    return modPow(base, ExponentWindows::build(exp));
+}
+
+}
+}
@@ -0,0 +1,222 @@
+#include "../../../include/crypto/algorithms/rsa/pollard_factorizer.hpp"
+#include "../../../include/crypto/io/async_processor.hpp"
+#include "../../../include/crypto/math/prime.hpp"
+#include <algorithm>
+#include <mutex>
+#include <vector>
+
+namespace crypto {
+namespace rsa {
+
+static bool properFactor(const BigInteger& g, const BigInteger& n) {
+    return !g.isOne() && g != n;
+}
+
+bool PollardFactorizer::splitTrivially(const BigInteger& n, BigInteger& factor) {
+    if (n.isEven()) {
+        factor = BigInteger(2);
+        return true;
+    }
+    
+    BigInteger root;
+    if (BigInteger::isPerfectSquare(n, root)) {
+        factor = root;
+        return true;
+    }
+    return false;
+}
+
+bool PollardFactorizer::brentWalk(const MontgomeryContext& mont, uint32_t increment,
+                                  uint64_t& budget, const std::atomic<bool>& cancel,
+                                  BigInteger& factor) {
+    const BigInteger& n = mont.modulus();
+    size_t k = mont.limbs();
+    std::vector<uint32_t> x(k), y(k), ys(k), q(k), c(k), diff(k), scratch(k + 2);
+    
+    mont.toLimbs(mont.toMontgomery(BigInteger(static_cast<int64_t>(increment))), c.data());
+    mont.toLimbs(mont.toMontgomery(BigInteger(2)), y.data());
+    std::copy(mont.oneLimbs(), mont.oneLimbs() + k, q.begin());
+    
+    auto step = [&](std::vector<uint32_t>& value) {
+        mont.mul(value.data(), value.data(), value.data(), scratch.data());
+        mont.add(value.data(), c.data(), value.data());
+    };
+    
+    BigInteger g(1);
+    for (uint64_t r = 1; g.isOne(); r <<= 1) {
+        x = y;
+        uint64_t advance = std::min(r, budget);
+        for (uint64_t i = 0; i < advance; ++i) {
+            step(y);
+        }
+        budget -= advance;
+        
+        for (uint64_t done = 0; done < r && g.isOne(); done += GCD_BATCH) {
+            if (cancel.load(std::memory_order_relaxed) || budget == 0) {
+                return false;
+            }
+            
+            ys = y;
+            uint64_t batch = std::min(GCD_BATCH, std::min(r - done, budget));
+            for (uint64_t i = 0; i < batch; ++i) {
+                step(y);
+                mont.sub(x.data(), y.data(), diff.data());
+                mont.mul(q.data(), diff.data(), q.data(), scratch.data());
+            }
+            budget -= batch;
+            g = BigInteger::gcd(mont.fromLimbs(q.data()), n);
+        }
+    }
+    
+    if (g == n) {
+        do {
+            step(ys);
+            mont.sub(x.data(), ys.data(), diff.data());
+            g = BigInteger::gcd(mont.fromLimbs(diff.data()), n);
+        } while (g.isOne());
+    }
+    
+    if (!properFactor(g, n)) {
+        return false;
+    }
+    factor = g;
+    return true;
+}
+
+bool PollardFactorizer::rho(const BigInteger& n, BigInteger& factor, uint64_t maxIterations,
+                            uint32_t increment) {
+    if (n <= BigInteger(3)) {
+        return false;
+    }
+    if (splitTrivially(n, factor)) {
+        return true;
+    }
+    
+    MontgomeryContext mont(n);
+    std::atomic<bool> cancel{false};
+    uint64_t budget = maxIterations;
+    while (budget > 0) {
+        if (brentWalk(mont, increment++, budget, cancel, factor)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool PollardFactorizer::rho(const BigInteger& n, BigInteger& factor, uint64_t maxIterations,
+                            ThreadPool& pool) {
+    if (n <= BigInteger(3)) {
+        return false;
+    }
+    if (splitTrivially(n, factor)) {
+        return true;
+    }
+    
+    MontgomeryContext mont(n);
+    std::atomic<bool> found{false};
+    std::mutex mutex;
+    uint32_t walks = static_cast<uint32_t>(pool.size() + 1);
+    
+    pool.parallelFor(walks, [&](size_t walk) {
+        uint64_t budget = maxIterations;
+        BigInteger candidate;
+        for (uint32_t increment = static_cast<uint32_t>(walk) + 1;
+             budget > 0 && !found.load(std::memory_order_relaxed); increment += walks) {
+            if (brentWalk(mont, increment, budget, found, candidate)) {
+                std::lock_guard<std::mutex> lock(mutex);
+                if (!found.exchange(true)) {
+                    factor = candidate;
+                }
+                return;
+            }
+        }
+    });
+    return found.load();
+}
+
+bool PollardFactorizer::pMinusOne(const BigInteger& n, BigInteger& factor, uint64_t bound) {
+    if (n <= BigInteger(3)) {
+        return false;
+    }
+    if (splitTrivially(n, factor)) {
+        return true;
+    }
+    
+    MontgomeryContext mont(n);
+    size_t k = mont.limbs();
+    std::vector<uint32_t> a(k), base(k), checkpoint(k), diff(k), scratch(k + 2);
+    mont.toLimbs(mont.toMontgomery(BigInteger(2)), a.data());
+    checkpoint = a;
+    
+    auto power = [&](std::vector<uint32_t>& value, uint64_t exponent) {
+        base = value;
+        int top = 63;
+        while (((exponent >> top) & 1) == 0) {
+            top--;
+        }
+        for (int bit = top - 1; bit >= 0; --bit) {
+            mont.mul(value.data(), value.data(), value.data(), scratch.data());
+            if ((exponent >> bit) & 1) {
+                mont.mul(value.data(), base.data(), value.data(), scratch.data());
+            }
+        }
+    };
+    
+    auto primePower = [bound](uint64_t p) {
+        uint64_t result = p;
+        while (result <= bound / p) {
+            result *= p;
+        }
+        return result;
+    };
+    
+    auto gcdWithN = [&](const std::vector<uint32_t>& value) {
+        mont.sub(value.data(), mont.oneLimbs(), diff.data());
+        return BigInteger::gcd(mont.fromLimbs(diff.data()), n);
+    };
+    
+    math::PrimeIterator primes(2);
+    uint64_t checkpointPrime = 2;
+    size_t sinceCheck = 0;
+    for (uint64_t p = primes.next(); ; p = primes.next()) {
+        bool last = p > bound;
+        if (!last) {
+            power(a, primePower(p));
+            if (++sinceCheck < STAGE1_CHECK_INTERVAL) {
+                continue;
+            }
+        }
+        
+        BigInteger g = gcdWithN(a);
+        if (properFactor(g, n)) {
+            factor = g;
+            return true;
+        }
+        if (g == n) {
+            a = checkpoint;
+            math::PrimeIterator replay(checkpointPrime);
+            for (uint64_t r = replay.next(); r <= p && r <= bound; r = replay.next()) {
+                power(a, primePower(r));
+                g = gcdWithN(a);
+                if (properFactor(g, n)) {
+                    factor = g;
+                    return true;
+                }
+                if (g == n) {
+                    return false;
+                }
+            }
+            return false;
+        }
+        if (last) {
+            return false;
+        }
+        
+        checkpoint = a;
+        checkpointPrime = p + 1;
+        sinceCheck = 0;
+    }
+}
+
+}
+}
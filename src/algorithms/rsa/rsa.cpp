@@ -6,12 +6,18 @@ namespace crypto {
 namespace rsa {
 
 RSA::RSA() : hasPrivateKey_(false) {
+    rebuildContext();
 }
 
 RSA::RSA(const RSAKey& key) : key_(key), hasPrivateKey_(key.isPrivate()) {
     if (!key_.isValid()) {
         throw CryptoException("Invalid RSA key");
     }
+    rebuildContext();
+}
+
+void RSA::rebuildContext() {
+    context_ = RSAContext::create(key_);
 }
 
 void RSA::setPublicKey(const BigInteger& n, const BigInteger& e) {
@@ -21,17 +27,20 @@ void RSA::setPublicKey(const BigInteger& n, const BigInteger& e) {
     key_.p = BigInteger(0);
     key_.q = BigInteger(0);
     hasPrivateKey_ = false;
+    rebuildContext();
 }
 
 void RSA::setPrivateKey(const BigInteger& n, const BigInteger& d) {
     key_.n = n;
     key_.d = d;
     hasPrivateKey_ = true;
+    rebuildContext();
 }
 
 void RSA::setKey(const RSAKey& key) {
     key_ = key;
     hasPrivateKey_ = key.isPrivate();
+    rebuildContext();
     if (!key_.isValid()) {
         throw CryptoException("Invalid RSA key");
     }
@@ -42,10 +51,7 @@ size_t RSA::blockSize() const {
 }
 
 size_t RSA::keySize() const {
-    if (key_.n.isZero()) {
-        return 0;
-    }
-    return (key_.n.bitLength() + 7) / 8;
+    return context_->modulusBytes();
 }
 
 void RSA::setKey(const Key& key) {
@@ -57,15 +63,14 @@ bool RSA::isValidKey(const Key& key) const {
 }
 
 size_t RSA::getBlockSize() const {
-    size_t modBits = key_.n.bitLength();
-    return (modBits + 7) / 8 - 1;
+    return context_->blockSize();
 }
 
 BigInteger RSA::encryptInteger(const BigInteger& m) const {
     if (m >= key_.n) {
         throw CryptoException("Message too large for RSA encryption");
     }
-    return BigInteger::modPow(m, key_.e, key_.n);
+    return context_->applyPublic(m);
 }
 
 BigInteger RSA::decryptInteger(const BigInteger& c) const {
@@ -75,7 +80,7 @@ BigInteger RSA::decryptInteger(const BigInteger& c) const {
     if (c >= key_.n) {
         throw CryptoException("Ciphertext too large");
     }
-    return BigInteger::modPow(c, key_.d, key_.n);
+    return context_->applyPrivate(c);
 }
 
 ByteArray RSA::encryptBlock(const ByteArray& block) const {
@@ -88,9 +93,9 @@ ByteArray RSA::encryptBlock(const ByteArray& block) const {
     
     ByteArray result = c.toBytes();
     
-    size_t modSize = (key_.n.bitLength() + 7) / 8;
-    while (result.size() < modSize) {
-        result.insert(result.begin(), 0);
+    size_t modSize = context_->modulusBytes();
+    if (result.size() < modSize) {
+        result.insert(result.begin(), modSize - result.size(), 0);
     }
     
     return result;
@@ -137,7 +142,7 @@ ByteArray RSA::decrypt(const ByteArray& ciphertext) {
         throw CryptoException("Private key required for decryption");
     }
     
-    size_t modSize = (key_.n.bitLength() + 7) / 8;
+    size_t modSize = context_->modulusBytes();
     if (ciphertext.size() % modSize != 0) {
         throw CryptoException("Invalid ciphertext size");
     }
@@ -0,0 +1,81 @@
+#include "../../../include/crypto/algorithms/rsa/rsa_context.hpp"
+#include "../../../include/crypto/core/exceptions.hpp"
+
+namespace crypto {
+namespace rsa {
+
+RSAContext::RSAContext(const RSAKey& key)
+    : n_(key.n)
+    , e_(key.e)
+    , d_(key.d)
+    , modulusBits_(key.n.bitLength())
+    , modulusBytes_((modulusBits_ + 7) / 8)
+    , hasPrivate_(key.isPrivate()) {
+
+    if (n_.sign() <= 0) {
+        return;
+    }
+
+    if (!n_.isEven()) {
+        mont_ = std::make_unique<const MontgomeryContext>(n_);
+    }
+    eWindows_ = ExponentWindows::build(e_);
+    dWindows_ = ExponentWindows::build(d_);
+
+    if (hasPrivate_ && canUseCRT(key)) {
+        BigInteger one(1);
+        auto params = std::make_unique<CRTParams>(key.p, key.q);
+        params->dp = ExponentWindows::build(key.d % (key.p - one));
+        params->dq = ExponentWindows::build(key.d % (key.q - one));
+        params->qInvMont = params->p.toMontgomery(BigInteger::modInv(key.q, key.p));
+        crt_ = std::move(params);
+    }
+}
+
+std::shared_ptr<const RSAContext> RSAContext::create(const RSAKey& key) {
+    return std::make_shared<const RSAContext>(key);
+}
+
+bool RSAContext::canUseCRT(const RSAKey& key) {
+    BigInteger one(1);
+    if (key.p <= one || key.q <= one || key.p == key.q) {
+        return false;
+    }
+    if (key.p.isEven() || key.q.isEven()) {
+        return false;
+    }
+    return key.p * key.q == key.n;
+}
+
+BigInteger RSAContext::applyPublic(const BigInteger& m) const {
+    if (!mont_) {
+        return BigInteger::modPow(m, e_, n_);
+    }
+    return mont_->modPow(m, eWindows_);
+}
+
+BigInteger RSAContext::applyPrivate(const BigInteger& c) const {
+    if (!hasPrivate_) {
+        throw CryptoException("Private key required for decryption");
+    }
+
+    if (crt_) {
+        BigInteger m1 = crt_->p.modPow(c, crt_->dp);
+        BigInteger m2 = crt_->q.modPow(c, crt_->dq);
+
+        BigInteger diff = m1 - crt_->p.reduce(m2);
+        if (diff.sign() < 0) {
+            diff += crt_->p.modulus();
+        }
+        BigInteger h = crt_->p.multiply(diff, crt_->qInvMont);
+        return m2 + h * crt_->q.modulus();
+    }
+
+    if (!mont_) {
+        return BigInteger::modPow(c, d_, n_);
+    }
+    return mont_->modPow(c, dWindows_);
+}
+
+}
+}
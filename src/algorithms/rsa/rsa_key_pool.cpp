@@ -0,0 +1,238 @@
+#include "../../../include/crypto/algorithms/rsa/rsa_key_pool.hpp"
+#include "../../../include/crypto/algorithms/rsa/rsa_keygen.hpp"
+#include "../../../include/crypto/core/exceptions.hpp"
+#include "../../../include/crypto/io/async_processor.hpp"
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#if defined(__linux__)
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#endif
+
+namespace crypto {
+namespace rsa {
+
+static void lowerThreadPriority() {
+#if defined(__linux__)
+    setpriority(PRIO_PROCESS, static_cast<id_t>(syscall(SYS_gettid)), 19);
+#endif
+}
+
+RSAKeyPool::RSAKeyPool(size_t backgroundThreads) {
+    if (backgroundThreads == 0) {
+        backgroundThreads = 1;
+    }
+    refillPool_ = std::make_unique<ThreadPool>(backgroundThreads);
+}
+
+RSAKeyPool::~RSAKeyPool() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+    }
+    refillPool_.reset();
+}
+
+void RSAKeyPool::setTarget(size_t keySizeBits, size_t count) {
+    if (keySizeBits < 32) {
+        throw CryptoException("RSA key size must be at least 32 bits");
+    }
+    
+    std::lock_guard<std::mutex> lock(mutex_);
+    Bucket& bucket = buckets_[keySizeBits];
+    bucket.target = count;
+    scheduleRefillLocked(keySizeBits, bucket);
+}
+
+size_t RSAKeyPool::target(size_t keySizeBits) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = buckets_.find(keySizeBits);
+    return it == buckets_.end() ? 0 : it->second.target;
+}
+
+size_t RSAKeyPool::available(size_t keySizeBits) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = buckets_.find(keySizeBits);
+    return it == buckets_.end() ? 0 : it->second.keys.size();
+}
+
+bool RSAKeyPool::tryAcquire(size_t keySizeBits, RSAKey& key) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = buckets_.find(keySizeBits);
+    if (it == buckets_.end() || it->second.keys.empty()) {
+        return false;
+    }
+    
+    key = std::move(it->second.keys.front());
+    it->second.keys.pop_front();
+    scheduleRefillLocked(keySizeBits, it->second);
+    return true;
+}
+
+RSAKey RSAKeyPool::acquire(size_t keySizeBits) {
+    RSAKey key;
+    if (tryAcquire(keySizeBits, key)) {
+        return key;
+    }
+    return RSAKeyGenerator::generate(keySizeBits);
+}
+
+bool RSAKeyPool::waitForKeys(size_t keySizeBits, size_t count, std::chrono::milliseconds timeout) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    return keyReady_.wait_for(lock, timeout, [&]() {
+        auto it = buckets_.find(keySizeBits);
+        return it != buckets_.end() && it->second.keys.size() >= count;
+    });
+}
+
+void RSAKeyPool::scheduleRefillLocked(size_t keySizeBits, Bucket& bucket) {
+    while (!stopping_ && bucket.keys.size() + bucket.pending < bucket.target) {
+        bucket.pending++;
+        try {
+            ThreadPool* pool = refillPool_.get();
+            pool->enqueue([this, pool, keySizeBits]() { refill(keySizeBits, *pool); });
+        } catch (...) {
+            bucket.pending--;
+            break;
+        }
+    }
+}
+
+void RSAKeyPool::refill(size_t keySizeBits, ThreadPool& pool) {
+    lowerThreadPriority();
+    
+    RSAKey key;
+    bool generated = false;
+    if (!stopping_) {
+        try {
+            key = RSAKeyGenerator::generate(keySizeBits, pool, 1);
+            generated = true;
+        } catch (...) {
+            generated = false;
+        }
+    }
+    
+    std::lock_guard<std::mutex> lock(mutex_);
+    Bucket& bucket = buckets_[keySizeBits];
+    bucket.pending--;
+    if (generated && !stopping_) {
+        bucket.keys.push_back(std::move(key));
+        keyReady_.notify_all();
+    }
+    scheduleRefillLocked(keySizeBits, bucket);
+}
+
+// The file holds private keys: it is written owner-only to a temporary name and renamed
+// into place, so a crash never leaves a truncated pool behind.
+static void writePrivateFile(const std::string& path, const std::string& contents) {
+    std::string temporary = path + ".tmp";
+    
+#if defined(__unix__) || defined(__APPLE__)
+    int fd = ::open(temporary.c_str(), O_WRONLY | O_CREAT | O_TRUNC, S_IRUSR | S_IWUSR);
+    if (fd < 0) {
+        throw CryptoException("RSAKeyPool: cannot open " + temporary + " for writing");
+    }
+    fchmod(fd, S_IRUSR | S_IWUSR);
+    
+    size_t written = 0;
+    while (written < contents.size()) {
+        ssize_t n = ::write(fd, contents.data() + written, contents.size() - written);
+        if (n <= 0) {
+            break;
+        }
+        written += static_cast<size_t>(n);
+    }
+    bool ok = written == contents.size() && fsync(fd) == 0;
+    ok = ::close(fd) == 0 && ok;
+#else
+    std::ofstream output(temporary, std::ios::binary | std::ios::trunc);
+    output << contents;
+    output.close();
+    bool ok = static_cast<bool>(output);
+#endif
+    
+    if (!ok || std::rename(temporary.c_str(), path.c_str()) != 0) {
+        std::remove(temporary.c_str());
+        throw CryptoException("RSAKeyPool: failed to write " + path);
+    }
+}
+
+void RSAKeyPool::save(const std::string& path) {
+    std::ostringstream output;
+    {
+        std::ifstream previous(path);
+        if (previous) {
+            output << previous.rdbuf();
+        }
+    }
+    
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (const auto& [bits, bucket] : buckets_) {
+        for (const RSAKey& key : bucket.keys) {
+            output << bits << ' ' << key.n.toHex() << ' ' << key.e.toHex() << ' '
+                   << key.d.toHex() << ' ' << key.p.toHex() << ' ' << key.q.toHex() << '\n';
+        }
+    }
+    
+    writePrivateFile(path, output.str());
+    
+    // The saved keys now belong to the file; keeping them would hand them out here and
+    // again after the file is loaded.
+    for (auto& [bits, bucket] : buckets_) {
+        bucket.keys.clear();
+        scheduleRefillLocked(bits, bucket);
+    }
+}
+
+size_t RSAKeyPool::load(const std::string& path) {
+    std::ifstream input(path);
+    if (!input) {
+        return 0;
+    }
+    
+    std::vector<std::pair<size_t, RSAKey>> keys;
+    std::string line;
+    while (std::getline(input, line)) {
+        std::istringstream fields(line);
+        size_t bits = 0;
+        std::string n, e, d, p, q;
+        if (!(fields >> bits >> n >> e >> d >> p >> q)) {
+            continue;
+        }
+        
+        RSAKey key(BigInteger::fromHex(n), BigInteger::fromHex(e), BigInteger::fromHex(d),
+                   BigInteger::fromHex(p), BigInteger::fromHex(q));
+        if (bits < 32 || key.n.bitLength() != bits || !key.isValid() || !key.isPrivate()) {
+            continue;
+        }
+        keys.emplace_back(bits, std::move(key));
+    }
+    input.close();
+    
+    // Loaded keys are consumed: leaving the file would hand the same keys out again after
+    // the next restart.
+    if (std::remove(path.c_str()) != 0) {
+        throw CryptoException("RSAKeyPool: cannot remove consumed key file " + path);
+    }
+    
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (auto& [bits, key] : keys) {
+        buckets_[bits].keys.push_back(std::move(key));
+    }
+    if (!keys.empty()) {
+        keyReady_.notify_all();
+    }
+    return keys.size();
+}
+
+}
+}
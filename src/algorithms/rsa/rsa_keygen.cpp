@@ -1,60 +1,273 @@
 #include "../../../include/crypto/algorithms/rsa/rsa_keygen.hpp"
 #include "../../../include/crypto/algorithms/rsa/big_integer.hpp"
+#include "../../../include/crypto/algorithms/rsa/montgomery.hpp"
 #include "../../../include/crypto/core/exceptions.hpp"
 #include "../../../include/crypto/math/prime.hpp"
-#include <random>
+#include "../../../include/crypto/io/async_processor.hpp"
 #include <cmath>
 #include <algorithm>
+#include <vector>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
 
 namespace crypto {
 namespace rsa {
 
+static constexpr uint64_t SIEVE_PRIME_LIMIT = 32768;
+static constexpr size_t SIEVE_WINDOW = 4096;
+static constexpr int MAX_SIEVE_WINDOWS = 1000;
+
+static const std::vector<uint32_t>& sievePrimes() {
+    static const std::vector<uint32_t> primes = [] {
+        const std::vector<uint32_t>& small = crypto::math::smallPrimes();
+        return std::vector<uint32_t>(small.begin() + 1,
+                                     std::lower_bound(small.begin(), small.end(), SIEVE_PRIME_LIMIT));
+    }();
+    return primes;
+}
+
+// The top two bits are set so that the product of two such primes has exactly twice as
+// many bits, which is what a key's size label promises.
+static BigInteger randomOddStart(size_t bits) {
+    BigInteger start = BigInteger::random(bits);
+    if (!start.testBit(bits - 1)) {
+        start += BigInteger(1) << (bits - 1);
+    }
+    if (!start.testBit(bits - 2)) {
+        start += BigInteger(1) << (bits - 2);
+    }
+    if (start.isEven()) {
+        start += BigInteger(1);
+    }
+    return start;
+}
+
+static void markMultiples(std::vector<bool>& composite, uint64_t first, uint64_t p) {
+    for (uint64_t j = first; j < composite.size(); j += p) {
+        composite[j] = true;
+    }
+}
+
+static void sieveWindow(const std::vector<uint32_t>& primes,
+                        const std::vector<uint32_t>& residues,
+                        std::vector<bool>& composite, bool safe) {
+    std::fill(composite.begin(), composite.end(), false);
+    
+    for (size_t i = 0; i < primes.size(); ++i) {
+        uint64_t p = primes[i];
+        uint64_t halfInverse = (p + 1) / 2;
+        markMultiples(composite, ((p - residues[i]) % p) * halfInverse % p, p);
+        if (safe) {
+            uint64_t target = (p - 1) / 2;
+            markMultiples(composite, ((target + p - residues[i]) % p) * halfInverse % p, p);
+        }
+    }
+}
+
 BigInteger RSAKeyGenerator::generatePrime(size_t bits) {
     if (bits <= 32) {
-        uint64_t prime = crypto::math::generatePrime(bits);
+        uint64_t prime = crypto::math::generatePrimeInRange(3ULL << (bits - 2), (1ULL << bits) - 1);
         return BigInteger(static_cast<int64_t>(prime));
     }
     
-    for (int attempts = 0; attempts < 1000; ++attempts) {
-        BigInteger candidate = BigInteger::random(bits);
-        
-        if (candidate.isEven()) {
-            BigInteger one(static_cast<int64_t>(1));
-            candidate = candidate + one;
-        }
-        
-        BigInteger two(static_cast<int64_t>(2));
-        BigInteger three(static_cast<int64_t>(3));
-        
-        if (candidate == two || candidate == three) {
-            return candidate;
-        }
+    std::atomic<bool> never(false);
+    BigInteger prime;
+    if (!searchPrime(bits, false, never, prime)) {
+        throw CryptoException("Could not generate prime number");
+    }
+    return prime;
+}
+
+bool RSAKeyGenerator::searchPrime(size_t bits, bool safe, const std::atomic<bool>& cancel,
+                                  BigInteger& prime) {
+    const std::vector<uint32_t>& primes = sievePrimes();
+    std::vector<uint32_t> residues(primes.size());
+    std::vector<bool> composite(SIEVE_WINDOW);
+    
+    if (safe) {
+        bits--;
+    }
+    
+    BigInteger start = randomOddStart(bits);
+    for (size_t i = 0; i < primes.size(); ++i) {
+        residues[i] = start.modSmall(primes[i]);
+    }
+    
+    for (int window = 0; window < MAX_SIEVE_WINDOWS; ++window) {
+        sieveWindow(primes, residues, composite, safe);
         
-        bool isPrime = true;
-        int smallPrimes[] = {3, 5, 7, 11, 13, 17, 19, 23, 29, 31, 37, 41, 43, 47};
-        for (int prime : smallPrimes) {
-            BigInteger divisor(static_cast<int64_t>(prime));
-            BigInteger remainder = candidate % divisor;
-            if (remainder.isZero()) {
-                isPrime = false;
+        for (size_t j = 0; j < SIEVE_WINDOW; ++j) {
+            if (composite[j]) {
+                continue;
+            }
+            if (cancel.load(std::memory_order_relaxed)) {
+                return false;
+            }
+            
+            BigInteger candidate = start + BigInteger(static_cast<int64_t>(2 * j));
+            if (candidate.bitLength() > bits) {
                 break;
             }
+            if (safe) {
+                BigInteger doubled = (candidate << 1) + BigInteger(1);
+                if (isSafePrimePair(candidate, doubled)) {
+                    prime = doubled;
+                    return true;
+                }
+            } else if (isProbablePrime(candidate)) {
+                prime = candidate;
+                return true;
+            }
         }
         
-        if (isPrime) {
-            
-            
-            if (bits > 32) {
-                if (isPrimeMillerRabin(candidate, 1)) {
-                    return candidate;
-                }
-            } else {
-                return candidate;
+        start += BigInteger(static_cast<int64_t>(2 * SIEVE_WINDOW));
+        if (start.bitLength() > bits) {
+            start = randomOddStart(bits);
+            for (size_t i = 0; i < primes.size(); ++i) {
+                residues[i] = start.modSmall(primes[i]);
+            }
+            continue;
+        }
+        for (size_t i = 0; i < primes.size(); ++i) {
+            residues[i] = static_cast<uint32_t>((residues[i] + 2 * SIEVE_WINDOW) % primes[i]);
+        }
+    }
+    
+    return false;
+}
+
+struct RSAKeyGenerator::PrimeSearch {
+    bool safe = false;
+    std::atomic<bool> found{false};
+    std::mutex mutex;
+    std::condition_variable finished;
+    BigInteger prime;
+    size_t running = 0;
+};
+
+void RSAKeyGenerator::runPrimeSearch(const std::shared_ptr<PrimeSearch>& search, size_t bits) {
+    BigInteger prime;
+    bool ok = false;
+    try {
+        ok = searchPrime(bits, search->safe, search->found, prime);
+    } catch (...) {
+        ok = false;
+    }
+    
+    std::lock_guard<std::mutex> lock(search->mutex);
+    if (ok && !search->found) {
+        search->prime = prime;
+        search->found = true;
+    }
+    search->running--;
+    search->finished.notify_all();
+}
+
+std::pair<BigInteger, BigInteger> RSAKeyGenerator::generatePrimePair(
+    size_t bits, ThreadPool& pool, size_t searchersPerPrime) {
+    
+    if (bits <= 32) {
+        BigInteger p = generatePrime(bits);
+        BigInteger q = generatePrime(bits);
+        while (q == p) {
+            q = generatePrime(bits);
+        }
+        return {p, q};
+    }
+    
+    if (searchersPerPrime == 0) {
+        searchersPerPrime = std::max<size_t>(1, pool.size() / 2);
+    }
+    
+    std::shared_ptr<PrimeSearch> searches[2] = {
+        std::make_shared<PrimeSearch>(), std::make_shared<PrimeSearch>()
+    };
+    for (const auto& search : searches) {
+        search->running = searchersPerPrime;
+    }
+    
+    // q's first walker always goes to the pool so the two primes are searched at the same
+    // time even with one searcher each. The caller takes it back if no worker has started
+    // it by the time p is found, so a caller running on a saturated pool cannot deadlock.
+    auto qClaimed = std::make_shared<std::atomic<bool>>(false);
+    auto firstQWalker = [qClaimed, search = searches[1], bits]() {
+        if (!qClaimed->exchange(true)) {
+            runPrimeSearch(search, bits);
+        }
+    };
+    try {
+        pool.enqueue(firstQWalker);
+    } catch (...) {
+    }
+    
+    for (size_t i = 1; i < searchersPerPrime; ++i) {
+        for (const auto& search : searches) {
+            try {
+                pool.enqueue([search, bits]() { runPrimeSearch(search, bits); });
+            } catch (...) {
+                std::lock_guard<std::mutex> lock(search->mutex);
+                search->running--;
             }
         }
     }
     
-    throw CryptoException("Could not generate prime number");
+    runPrimeSearch(searches[0], bits);
+    firstQWalker();
+    
+    BigInteger primes[2] = {awaitPrimeSearch(*searches[0]), awaitPrimeSearch(*searches[1])};
+    
+    while (primes[1] == primes[0]) {
+        primes[1] = generatePrime(bits);
+    }
+    
+    return {primes[0], primes[1]};
+}
+
+BigInteger RSAKeyGenerator::awaitPrimeSearch(PrimeSearch& search) {
+    std::unique_lock<std::mutex> lock(search.mutex);
+    search.finished.wait(lock, [&]() {
+        return search.found || search.running == 0;
+    });
+    if (!search.found) {
+        throw CryptoException("Could not generate prime number");
+    }
+    return search.prime;
+}
+
+BigInteger RSAKeyGenerator::generateSafePrime(size_t bits) {
+    return generateSafePrime(bits, defaultPool());
+}
+
+BigInteger RSAKeyGenerator::generateSafePrime(size_t bits, ThreadPool& pool, size_t searchers) {
+    if (bits < 32) {
+        throw CryptoException("Safe prime size must be at least 32 bits");
+    }
+    
+    if (searchers == 0) {
+        searchers = std::max<size_t>(1, pool.size());
+    }
+    
+    auto search = std::make_shared<PrimeSearch>();
+    search->safe = true;
+    search->running = searchers;
+    
+    for (size_t i = 1; i < searchers; ++i) {
+        try {
+            pool.enqueue([search, bits]() { runPrimeSearch(search, bits); });
+        } catch (...) {
+            std::lock_guard<std::mutex> lock(search->mutex);
+            search->running--;
+        }
+    }
+    
+    runPrimeSearch(search, bits);
+    return awaitPrimeSearch(*search);
+}
+
+ThreadPool& RSAKeyGenerator::defaultPool() {
+    static ThreadPool pool(std::max<size_t>(2, std::thread::hardware_concurrency()));
+    return pool;
 }
 
 BigInteger RSAKeyGenerator::choosePublicExponent(const BigInteger& phi) {
@@ -122,14 +335,17 @@ BigInteger RSAKeyGenerator::computePrivateExponentSecure(
 }
 
 RSAKey RSAKeyGenerator::generate(size_t keySizeBits) {
+    return generate(keySizeBits, defaultPool());
+}
+
+RSAKey RSAKeyGenerator::generate(size_t keySizeBits, ThreadPool& pool, size_t searchersPerPrime) {
     if (keySizeBits < 32) {
         throw CryptoException("RSA key size must be at least 32 bits");
     }
     
     size_t halfBits = keySizeBits / 2;
     
-    BigInteger p = generatePrime(halfBits);
-    BigInteger q = generatePrime(halfBits);
+    auto [p, q] = generatePrimePair(halfBits, pool, searchersPerPrime);
     
     BigInteger n = p * q;
     
@@ -145,14 +361,17 @@ RSAKey RSAKeyGenerator::generate(size_t keySizeBits) {
 }
 
 RSAKey RSAKeyGenerator::generateSecure(size_t keySizeBits) {
+    return generateSecure(keySizeBits, defaultPool());
+}
+
+RSAKey RSAKeyGenerator::generateSecure(size_t keySizeBits, ThreadPool& pool, size_t searchersPerPrime) {
     if (keySizeBits < 512) {
         throw CryptoException("Secure RSA key size must be at least 512 bits");
     }
     
     size_t halfBits = keySizeBits / 2;
     
-    BigInteger p = generatePrime(halfBits);
-    BigInteger q = generatePrime(halfBits);
+    auto [p, q] = generatePrimePair(halfBits, pool, searchersPerPrime);
     
     BigInteger n = p * q;
     
@@ -175,62 +394,188 @@ bool RSAKeyGenerator::isVulnerableToWiener(const RSAKey& key) {
     return !satisfiesWienerProtection(key.d, key.n);
 }
 
-bool RSAKeyGenerator::isPrimeMillerRabin(const BigInteger& n, int k) {
+static constexpr uint32_t TRIAL_DIVISION_LIMIT = 256;
+static constexpr int SQUARE_CHECK_AFTER = 8;
+
+static int jacobiSmall(uint64_t a, uint64_t n) {
+    a %= n;
+    int result = 1;
+    while (a != 0) {
+        while ((a & 1) == 0) {
+            a >>= 1;
+            uint64_t r = n & 7;
+            if (r == 3 || r == 5) {
+                result = -result;
+            }
+        }
+        std::swap(a, n);
+        if ((a & 3) == 3 && (n & 3) == 3) {
+            result = -result;
+        }
+        a %= n;
+    }
+    return n == 1 ? result : 0;
+}
+
+static int jacobi(int64_t d, const BigInteger& n) {
+    uint64_t magnitude = static_cast<uint64_t>(d < 0 ? -d : d);
+    int result = 1;
+    
+    if (d < 0 && n.modSmall(4) == 3) {
+        result = -result;
+    }
+    while ((magnitude & 1) == 0) {
+        magnitude >>= 1;
+        uint32_t r = n.modSmall(8);
+        if (r == 3 || r == 5) {
+            result = -result;
+        }
+    }
+    if (magnitude == 1) {
+        return result;
+    }
+    
+    if ((magnitude & 3) == 3 && n.modSmall(4) == 3) {
+        result = -result;
+    }
+    return result * jacobiSmall(n.modSmall(static_cast<uint32_t>(magnitude)), magnitude);
+}
+
+bool RSAKeyGenerator::isProbablePrime(const BigInteger& n) {
     if (n < BigInteger(2)) return false;
-    if (n == BigInteger(2) || n == BigInteger(3)) return true;
-    if (n.isEven()) return false;
+    if (n.isEven()) return n == BigInteger(2);
     
+    for (uint32_t p : sievePrimes()) {
+        if (p >= TRIAL_DIVISION_LIMIT) {
+            break;
+        }
+        if (n.modSmall(p) == 0) {
+            return n == BigInteger(static_cast<int64_t>(p));
+        }
+        if (n < BigInteger(static_cast<int64_t>(p) * p)) {
+            return true;
+        }
+    }
+    
+    MontgomeryContext mont(n);
+    return isStrongProbablePrimeBase2(mont) && isStrongLucasProbablePrime(mont);
+}
+
+bool RSAKeyGenerator::isStrongProbablePrimeBase2(const MontgomeryContext& mont) {
+    const BigInteger& n = mont.modulus();
+    size_t k = mont.limbs();
     
     BigInteger d = n - BigInteger(1);
-    int r = 0;
+    size_t s = 0;
     while (d.isEven()) {
         d = d >> 1;
-        r++;
+        s++;
     }
     
-    std::random_device rd;
-    std::mt19937 gen(rd());
+    std::vector<uint32_t> x(k), base(k), minusOne(k), scratch(k + 2);
+    mont.add(mont.oneLimbs(), mont.oneLimbs(), base.data());
+    std::fill(minusOne.begin(), minusOne.end(), 0u);
+    mont.sub(minusOne.data(), mont.oneLimbs(), minusOne.data());
     
-    BigInteger nMinus2 = n - BigInteger(2);
-    BigInteger two(2);
+    std::copy(base.begin(), base.end(), x.begin());
+    for (size_t bit = d.bitLength() - 1; bit > 0; --bit) {
+        mont.mul(x.data(), x.data(), x.data(), scratch.data());
+        if (d.testBit(bit - 1)) {
+            mont.add(x.data(), x.data(), x.data());
+        }
+    }
     
+    if (std::equal(x.begin(), x.end(), mont.oneLimbs()) || x == minusOne) {
+        return true;
+    }
+    for (size_t r = 1; r < s; ++r) {
+        mont.mul(x.data(), x.data(), x.data(), scratch.data());
+        if (x == minusOne) {
+            return true;
+        }
+        if (std::equal(x.begin(), x.end(), mont.oneLimbs())) {
+            return false;
+        }
+    }
+    return false;
+}
+
+bool RSAKeyGenerator::isSafePrimePair(const BigInteger& q, const BigInteger& p) {
+    MontgomeryContext qMont(q);
+    if (!isStrongProbablePrimeBase2(qMont)) {
+        return false;
+    }
+    MontgomeryContext pMont(p);
+    if (!isStrongProbablePrimeBase2(pMont)) {
+        return false;
+    }
+    return isStrongLucasProbablePrime(qMont);
+}
+
+bool RSAKeyGenerator::isStrongLucasProbablePrime(const MontgomeryContext& mont) {
+    const BigInteger& n = mont.modulus();
+    size_t k = mont.limbs();
+    
+    int64_t D = 5;
+    for (int attempt = 0;; ++attempt) {
+        int symbol = jacobi(D, n);
+        if (symbol == -1) {
+            break;
+        }
+        if (symbol == 0 && n != BigInteger(D < 0 ? -D : D)) {
+            return false;
+        }
+        if (attempt == SQUARE_CHECK_AFTER && BigInteger::isPerfectSquare(n)) {
+            return false;
+        }
+        D = D < 0 ? -D + 2 : -(D + 2);
+    }
     
+    std::vector<uint32_t> dMont(k), qMont(k);
+    mont.toLimbs(mont.toMontgomery(BigInteger(D)), dMont.data());
+    mont.toLimbs(mont.toMontgomery(BigInteger((1 - D) / 4)), qMont.data());
     
+    BigInteger d = n + BigInteger(1);
+    size_t s = 0;
+    while (d.isEven()) {
+        d = d >> 1;
+        s++;
+    }
     
-    int smallBases[] = {2, 3, 5};
-    int numBases = std::min(k, 3);
+    std::vector<uint32_t> u(mont.oneLimbs(), mont.oneLimbs() + k);
+    std::vector<uint32_t> v(u), qk(qMont), t(k), scratch(k + 2);
     
-    for (int i = 0; i < numBases; ++i) {
-        BigInteger a(smallBases[i]);
-        
-        
-        if (a >= nMinus2) {
-            continue;
-        }
-        
-        BigInteger x = BigInteger::modPow(a, d, n);
+    for (size_t bit = d.bitLength() - 1; bit > 0; --bit) {
+        mont.mul(u.data(), v.data(), u.data(), scratch.data());
+        mont.mul(v.data(), v.data(), v.data(), scratch.data());
+        mont.sub(v.data(), qk.data(), v.data());
+        mont.sub(v.data(), qk.data(), v.data());
+        mont.mul(qk.data(), qk.data(), qk.data(), scratch.data());
         
-        if (x == BigInteger(1) || x == nMinus2) {
-            continue;
-        }
-        
-        bool composite = true;
-        for (int j = 0; j < r - 1; ++j) {
-            x = BigInteger::modPow(x, two, n);
-            if (x == nMinus2) {
-                composite = false;
-                break;
-            }
-        }
-        
-        if (composite) {
-            return false;
+        if (d.testBit(bit - 1)) {
+            mont.mul(dMont.data(), u.data(), t.data(), scratch.data());
+            mont.add(u.data(), v.data(), u.data());
+            mont.halve(u.data());
+            mont.add(t.data(), v.data(), v.data());
+            mont.halve(v.data());
+            mont.mul(qk.data(), qMont.data(), qk.data(), scratch.data());
         }
     }
     
-    return true;
+    if (mont.isZero(u.data()) || mont.isZero(v.data())) {
+        return true;
+    }
+    for (size_t r = 1; r < s; ++r) {
+        mont.mul(v.data(), v.data(), v.data(), scratch.data());
+        mont.sub(v.data(), qk.data(), v.data());
+        mont.sub(v.data(), qk.data(), v.data());
+        if (mont.isZero(v.data())) {
+            return true;
+        }
+        mont.mul(qk.data(), qk.data(), qk.data(), scratch.data());
+    }
+    return false;
 }
 
 }
 }
-
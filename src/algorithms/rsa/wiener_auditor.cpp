@@ -0,0 +1,140 @@
+#include "../../../include/crypto/algorithms/rsa/wiener_auditor.hpp"
+#include "../../../include/crypto/algorithms/rsa/wiener_attack.hpp"
+#include "../../../include/crypto/core/exceptions.hpp"
+#include "../../../include/crypto/io/async_processor.hpp"
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <fstream>
+#include <mutex>
+#include <sstream>
+
+namespace crypto {
+namespace rsa {
+
+static double secondsSince(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+static bool isHex(const std::string& field) {
+    size_t start = field.compare(0, 2, "0x") == 0 ? 2 : 0;
+    if (start == field.size()) {
+        return false;
+    }
+    return std::all_of(field.begin() + start, field.end(), [](char c) {
+        return std::isxdigit(static_cast<unsigned char>(c)) != 0;
+    });
+}
+
+double WienerAuditReport::keysPerSecond() const {
+    return elapsedSeconds > 0.0 ? keysRead / elapsedSeconds : 0.0;
+}
+
+void WienerAuditor::auditBatch(size_t count, const KeyLoader& load, ThreadPool& pool,
+                               WienerAuditReport& report) {
+    std::mutex mutex;
+    
+    pool.parallelFor(count, [&](size_t i) {
+        size_t line = 0;
+        BigInteger n, e;
+        if (!load(i, line, n, e)) {
+            std::lock_guard<std::mutex> lock(mutex);
+            report.malformed++;
+            return;
+        }
+        if (!WienerAttack::isVulnerable(n, e)) {
+            return;
+        }
+        
+        auto start = std::chrono::steady_clock::now();
+        BigInteger d, p, q;
+        bool found = WienerAttack::attack(n, e, d, p, q);
+        double seconds = secondsSince(start);
+        
+        std::lock_guard<std::mutex> lock(mutex);
+        report.attacked++;
+        report.attackSeconds += seconds;
+        report.slowestAttackSeconds = std::max(report.slowestAttackSeconds, seconds);
+        if (found) {
+            report.vulnerable.push_back({line, n, e, d, p, q});
+        }
+    });
+}
+
+void WienerAuditor::auditEntries(const std::vector<Entry>& batch, ThreadPool& pool,
+                                 WienerAuditReport& report) {
+    auditBatch(batch.size(), [&](size_t i, size_t& line, BigInteger& n, BigInteger& e) {
+        const Entry& entry = batch[i];
+        if (!isHex(entry.n) || !isHex(entry.e)) {
+            return false;
+        }
+        line = entry.line;
+        n = BigInteger::fromHex(entry.n);
+        e = BigInteger::fromHex(entry.e);
+        return true;
+    }, pool, report);
+}
+
+WienerAuditReport WienerAuditor::audit(const std::vector<std::pair<BigInteger, BigInteger>>& keys,
+                                       ThreadPool& pool) {
+    auto start = std::chrono::steady_clock::now();
+    WienerAuditReport report;
+    report.keysRead = keys.size();
+    auditBatch(keys.size(), [&](size_t i, size_t& line, BigInteger& n, BigInteger& e) {
+        line = i + 1;
+        n = keys[i].first;
+        e = keys[i].second;
+        return true;
+    }, pool, report);
+    std::sort(report.vulnerable.begin(), report.vulnerable.end(),
+              [](const WienerFinding& a, const WienerFinding& b) { return a.line < b.line; });
+    report.elapsedSeconds = secondsSince(start);
+    return report;
+}
+
+WienerAuditReport WienerAuditor::auditStream(std::istream& input, ThreadPool& pool, size_t batchSize) {
+    if (batchSize == 0) {
+        throw CryptoException("WienerAuditor: batch size must be positive");
+    }
+    
+    auto start = std::chrono::steady_clock::now();
+    WienerAuditReport report;
+    std::vector<Entry> batch;
+    batch.reserve(batchSize);
+    
+    std::string line;
+    size_t lineNumber = 0;
+    while (std::getline(input, line)) {
+        lineNumber++;
+        std::istringstream fields(line);
+        Entry entry{lineNumber, "", ""};
+        if (!(fields >> entry.n) || entry.n[0] == '#') {
+            continue;
+        }
+        fields >> entry.e;
+        
+        report.keysRead++;
+        batch.push_back(std::move(entry));
+        if (batch.size() == batchSize) {
+            auditEntries(batch, pool, report);
+            batch.clear();
+        }
+    }
+    auditEntries(batch, pool, report);
+    
+    std::sort(report.vulnerable.begin(), report.vulnerable.end(),
+              [](const WienerFinding& a, const WienerFinding& b) { return a.line < b.line; });
+    report.elapsedSeconds = secondsSince(start);
+    return report;
+}
+
+WienerAuditReport WienerAuditor::auditFile(const std::string& path, ThreadPool& pool, size_t batchSize) {
+    std::ifstream input(path);
+    if (!input) {
+        throw CryptoException("WienerAuditor: cannot open " + path);
+    }
+    return auditStream(input, pool, batchSize);
+}
+
+}
+}
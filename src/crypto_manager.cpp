@@ -49,6 +49,7 @@ CipherMode CryptoManager::parseMode(const std::string& modeName) const {
     if (mode == "OFB") return CipherMode::OFB;
     if (mode == "CTR") return CipherMode::CTR;
     if (mode == "RANDOMDELTA" || mode == "RANDOM_DELTA") return CipherMode::RANDOM_DELTA;
+    if (mode == "GCM") return CipherMode::GCM;
     
     throw CryptoException("Unknown mode: " + modeName);
 }
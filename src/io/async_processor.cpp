@@ -20,9 +20,11 @@ ThreadPool::ThreadPool(size_t threads) {
                     
                     task = std::move(tasks_.front());
                     tasks_.pop();
+                    active_++;
                 }
                 
                 task();
+                active_--;
             }
         });
     }
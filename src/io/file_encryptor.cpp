@@ -34,44 +34,16 @@ std::future<bool> AsyncFileEncryptor::decryptFileAsync(const std::string& inputF
 
 bool AsyncFileEncryptor::encryptFileSync(const std::string& inputFile,
                                         const std::string& outputFile) {
-    try {
-        std::ifstream input(inputFile, std::ios::binary);
-        std::ofstream output(outputFile, std::ios::binary);
-        
-        if (!input || !output) {
-            return false;
-        }
-        
-        
-        ByteArray buffer(chunkSize_);
-        while (input.read(reinterpret_cast<char*>(buffer.data()), chunkSize_)) {
-            size_t bytesRead = input.gcount();
-            if (bytesRead < chunkSize_) {
-                buffer.resize(bytesRead);
-            }
-            
-            ByteArray encrypted = mode_->encrypt(buffer);
-            output.write(reinterpret_cast<const char*>(encrypted.data()), 
-                        encrypted.size());
-        }
-        
-        
-        size_t bytesRead = input.gcount();
-        if (bytesRead > 0) {
-            buffer.resize(bytesRead);
-            ByteArray encrypted = mode_->encrypt(buffer);
-            output.write(reinterpret_cast<const char*>(encrypted.data()), 
-                        encrypted.size());
-        }
-        
-        return true;
-    } catch (...) {
-        return false;
-    }
+    return streamFile(inputFile, outputFile, true);
 }
 
 bool AsyncFileEncryptor::decryptFileSync(const std::string& inputFile,
                                         const std::string& outputFile) {
+    return streamFile(inputFile, outputFile, false);
+}
+
+bool AsyncFileEncryptor::streamFile(const std::string& inputFile,
+                                    const std::string& outputFile, bool encrypting) {
     try {
         std::ifstream input(inputFile, std::ios::binary);
         std::ofstream output(outputFile, std::ios::binary);
@@ -80,33 +52,33 @@ bool AsyncFileEncryptor::decryptFileSync(const std::string& inputFile,
             return false;
         }
         
+        std::lock_guard<std::mutex> lock(modeMutex_);
+        if (encrypting) {
+            mode_->startEncryption();
+        } else {
+            mode_->startDecryption();
+        }
         
         ByteArray buffer(chunkSize_);
-        while (input.read(reinterpret_cast<char*>(buffer.data()), chunkSize_)) {
-            size_t bytesRead = input.gcount();
-            if (bytesRead < chunkSize_) {
-                buffer.resize(bytesRead);
+        ByteArray processed(chunkSize_ + MAX_BLOCK_SIZE);
+        while (input) {
+            input.read(reinterpret_cast<char*>(buffer.data()), chunkSize_);
+            size_t bytesRead = static_cast<size_t>(input.gcount());
+            if (bytesRead == 0) {
+                break;
             }
             
-            ByteArray decrypted = mode_->decrypt(buffer);
-            output.write(reinterpret_cast<const char*>(decrypted.data()), 
-                        decrypted.size());
+            size_t written = mode_->update(buffer.data(), bytesRead, processed.data());
+            output.write(reinterpret_cast<const char*>(processed.data()), written);
         }
         
+        size_t written = mode_->finalize(processed.data());
+        output.write(reinterpret_cast<const char*>(processed.data()), written);
         
-        size_t bytesRead = input.gcount();
-        if (bytesRead > 0) {
-            buffer.resize(bytesRead);
-            ByteArray decrypted = mode_->decrypt(buffer);
-            output.write(reinterpret_cast<const char*>(decrypted.data()), 
-                        decrypted.size());
-        }
-        
-        return true;
+        return static_cast<bool>(output);
     } catch (...) {
         return false;
     }
 }
 
-}
-
+}
\ No newline at end of file
@@ -0,0 +1,114 @@
+#include "../../include/crypto/io/xts_file.hpp"
+#include <algorithm>
+#include <cstring>
+
+namespace crypto {
+
+XTSFile::XTSFile(const std::string& path, std::shared_ptr<XTSMode> mode)
+    : mode_(std::move(mode))
+    , size_(0) {
+    
+    if (!mode_) {
+        throw CryptoException("XTS mode cannot be null");
+    }
+    
+    file_.open(path, std::ios::in | std::ios::out | std::ios::binary);
+    if (!file_) {
+        std::ofstream(path, std::ios::binary);
+        file_.open(path, std::ios::in | std::ios::out | std::ios::binary);
+    }
+    if (!file_) {
+        throw CryptoException("Cannot open file: " + path);
+    }
+    
+    file_.seekg(0, std::ios::end);
+    size_ = static_cast<uint64_t>(file_.tellg());
+    if (size_ % mode_->sectorSize() != 0) {
+        throw CryptoException("XTS image size must be a multiple of the sector size");
+    }
+}
+
+void XTSFile::readSectors(uint64_t firstSector, Byte* output, size_t sectors) {
+    size_t bytes = sectors * mode_->sectorSize();
+    file_.seekg(static_cast<std::streamoff>(firstSector * mode_->sectorSize()));
+    file_.read(reinterpret_cast<char*>(output), static_cast<std::streamsize>(bytes));
+    if (!file_) {
+        file_.clear();
+        throw CryptoException("Failed to read XTS sectors");
+    }
+    mode_->decryptSectors(firstSector, output, output, bytes);
+}
+
+void XTSFile::writeSectors(uint64_t firstSector, Byte* data, size_t sectors) {
+    size_t bytes = sectors * mode_->sectorSize();
+    mode_->encryptSectors(firstSector, data, data, bytes);
+    file_.seekp(static_cast<std::streamoff>(firstSector * mode_->sectorSize()));
+    file_.write(reinterpret_cast<const char*>(data), static_cast<std::streamsize>(bytes));
+    if (!file_) {
+        file_.clear();
+        throw CryptoException("Failed to write XTS sectors");
+    }
+}
+
+size_t XTSFile::read(uint64_t offset, Byte* output, size_t length) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (offset >= size_ || length == 0) {
+        return 0;
+    }
+    length = static_cast<size_t>(std::min<uint64_t>(length, size_ - offset));
+    
+    size_t sectorSize = mode_->sectorSize();
+    uint64_t first = offset / sectorSize;
+    uint64_t end = (offset + length + sectorSize - 1) / sectorSize;
+    ByteArray buffer(static_cast<size_t>(end - first) * sectorSize);
+    readSectors(first, buffer.data(), static_cast<size_t>(end - first));
+    
+    std::memcpy(output, buffer.data() + (offset - first * sectorSize), length);
+    return length;
+}
+
+ByteArray XTSFile::read(uint64_t offset, size_t length) {
+    ByteArray data(length);
+    data.resize(read(offset, data.data(), length));
+    return data;
+}
+
+void XTSFile::write(uint64_t offset, const Byte* data, size_t length) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (length == 0) {
+        return;
+    }
+    
+    size_t sectorSize = mode_->sectorSize();
+    uint64_t stored = size_ / sectorSize;
+    uint64_t first = std::min(offset / sectorSize, stored);
+    uint64_t end = (offset + length + sectorSize - 1) / sectorSize;
+    size_t sectors = static_cast<size_t>(end - first);
+    ByteArray buffer(sectors * sectorSize, 0);
+    
+    // Only the partially overwritten edge sectors need their old contents.
+    if (offset % sectorSize != 0 && offset / sectorSize < stored) {
+        uint64_t head = offset / sectorSize;
+        readSectors(head, buffer.data() + (head - first) * sectorSize, 1);
+    }
+    uint64_t tail = end - 1;
+    if ((offset + length) % sectorSize != 0 && tail < stored &&
+        (tail != offset / sectorSize || offset % sectorSize == 0)) {
+        readSectors(tail, buffer.data() + (tail - first) * sectorSize, 1);
+    }
+    
+    std::memcpy(buffer.data() + (offset - first * sectorSize), data, length);
+    writeSectors(first, buffer.data(), sectors);
+    size_ = std::max(size_, end * sectorSize);
+}
+
+void XTSFile::write(uint64_t offset, const ByteArray& data) {
+    write(offset, data.data(), data.size());
+}
+
+void XTSFile::flush() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    file_.flush();
+}
+
+}
\ No newline at end of file
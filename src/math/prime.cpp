@@ -1,41 +1,60 @@
 
 #include "../../include/crypto/math/prime.hpp"
 #include "../../include/crypto/core/utils.hpp"
+#include "../../include/crypto/math/random.hpp"
 #include <random>
 #include <cmath>
 #include <algorithm>
+#include <array>
+#include <atomic>
 #include <cassert>
+#include <exception>
+#include <thread>
 
 namespace crypto {
 namespace math {
 
+static constexpr uint64_t TRIAL_DIVISION_LIMIT = 1ULL << 20;
+
+static constexpr uint64_t MILLER_RABIN_BASES[] = {
+    2, 325, 9375, 28178, 450775, 9780504, 1795265022
+};
+
 bool isPrime(uint64_t n) {
     if (n < 2) return false;
     if (n == 2 || n == 3) return true;
     if (n % 2 == 0 || n % 3 == 0) return false;
+    if (n >= TRIAL_DIVISION_LIMIT) return isPrimeMillerRabin(n);
     
-    for (uint64_t i = 5; i * i <= n; i += 6) {
-        if (n % i == 0 || n % (i + 2) == 0) {
+    for (uint32_t p : smallPrimes()) {
+        if (static_cast<uint64_t>(p) * p > n) {
+            break;
+        }
+        if (n % p == 0) {
             return false;
         }
     }
     return true;
 }
 
+static uint64_t mulMod(uint64_t a, uint64_t b, uint64_t mod) {
+    return static_cast<uint64_t>(static_cast<unsigned __int128>(a) * b % mod);
+}
+
 static uint64_t modPow(uint64_t base, uint64_t exp, uint64_t mod) {
     uint64_t result = 1;
     base = base % mod;
     while (exp > 0) {
         if (exp % 2 == 1) {
-            result = (result * base) % mod;
+            result = mulMod(result, base, mod);
         }
         exp = exp >> 1;
-        base = (base * base) % mod;
+        base = mulMod(base, base, mod);
     }
     return result;
 }
 
-bool isPrimeMillerRabin(uint64_t n, int k) {
+bool isPrimeMillerRabin(uint64_t n) {
     if (n < 2) return false;
     if (n == 2 || n == 3) return true;
     if (n % 2 == 0) return false;
@@ -47,12 +66,11 @@ bool isPrimeMillerRabin(uint64_t n, int k) {
         r++;
     }
     
-    std::random_device rd;
-    std::mt19937 gen(rd());
-    std::uniform_int_distribution<uint64_t> dis(2, n - 2);
-    
-    for (int i = 0; i < k; ++i) {
-        uint64_t a = dis(gen);
+    for (uint64_t base : MILLER_RABIN_BASES) {
+        uint64_t a = base % n;
+        if (a == 0) {
+            continue;
+        }
         uint64_t x = modPow(a, d, n);
         
         if (x == 1 || x == n - 1) {
@@ -61,7 +79,7 @@ bool isPrimeMillerRabin(uint64_t n, int k) {
         
         bool composite = true;
         for (int j = 0; j < r - 1; ++j) {
-            x = (x * x) % n;
+            x = mulMod(x, x, n);
             if (x == n - 1) {
                 composite = false;
                 break;
@@ -77,8 +95,11 @@ bool isPrimeMillerRabin(uint64_t n, int k) {
 }
 
 uint64_t generatePrime(uint64_t minBits) {
-    if (minBits > 32) {
-        minBits = 32;
+    if (minBits > 64) {
+        minBits = 64;
+    }
+    if (minBits < 2) {
+        minBits = 2;
     }
     
     uint64_t min = 1ULL << (minBits - 1);
@@ -92,14 +113,13 @@ uint64_t generatePrimeInRange(uint64_t min, uint64_t max) {
         std::swap(min, max);
     }
     
-    std::random_device rd;
-    std::mt19937 gen(rd());
+    SecureRandom rng;
     std::uniform_int_distribution<uint64_t> dis(min, max);
     
     if (min % 2 == 0) min++;
     
     for (int attempts = 0; attempts < 10000; ++attempts) {
-        uint64_t candidate = dis(gen);
+        uint64_t candidate = dis(rng);
         if (candidate % 2 == 0) {
             candidate++;
         }
@@ -114,7 +134,7 @@ uint64_t generatePrimeInRange(uint64_t min, uint64_t max) {
         }
     }
     
-    for (uint64_t n = min; n <= max; n += 2) {
+    for (uint64_t n = min; n <= max && n >= min; n += 2) {
         if (isPrimeMillerRabin(n)) {
             return n;
         }
@@ -123,30 +143,302 @@ uint64_t generatePrimeInRange(uint64_t min, uint64_t max) {
     throw CryptoException("Could not generate prime in range");
 }
 
-std::vector<uint64_t> sieveOfEratosthenes(uint64_t limit) {
-    if (limit < 2) return {};
+static constexpr uint64_t WHEEL = 30;
+static constexpr uint8_t WHEEL_RESIDUES[8] = {1, 7, 11, 13, 17, 19, 23, 29};
+static constexpr uint8_t WHEEL_GAPS[8] = {6, 4, 2, 4, 2, 4, 6, 2};
+static constexpr size_t SEGMENT_BYTES = 32 * 1024;
+static constexpr uint64_t SEGMENT_SPAN = SEGMENT_BYTES * WHEEL;
+static constexpr uint64_t SEGMENTS_PER_CHUNK = 16;
+static constexpr uint64_t SMALL_PRIME_LIMIT = 1ULL << 16;
+static constexpr uint64_t MAX_SIEVE_LIMIT = 1ULL << 62;
+static constexpr uint64_t PARALLEL_SIEVE_THRESHOLD = 1ULL << 24;
+
+static const uint8_t* wheelIndex() {
+    static const auto table = [] {
+        std::array<uint8_t, WHEEL> result;
+        result.fill(0xFF);
+        for (uint8_t i = 0; i < 8; ++i) {
+            result[WHEEL_RESIDUES[i]] = i;
+        }
+        return result;
+    }();
+    return table.data();
+}
+
+static uint64_t isqrt(uint64_t n) {
+    uint64_t r = static_cast<uint64_t>(std::sqrt(static_cast<double>(n)));
+    while (r > 0 && r > n / r) r--;
+    while ((r + 1) <= n / (r + 1)) r++;
+    return r;
+}
+
+static std::vector<uint32_t> simpleSieve(uint64_t limit) {
+    std::vector<uint32_t> primes;
+    if (limit < 2) return primes;
     
-    std::vector<bool> isPrime(limit + 1, true);
-    isPrime[0] = isPrime[1] = false;
+    std::vector<bool> composite(limit / 2 + 1, false);
+    primes.push_back(2);
+    for (uint64_t i = 3; i <= limit; i += 2) {
+        if (composite[i / 2]) {
+            continue;
+        }
+        primes.push_back(static_cast<uint32_t>(i));
+        for (uint64_t j = i * i; j <= limit; j += 2 * i) {
+            composite[j / 2] = true;
+        }
+    }
+    return primes;
+}
+
+static std::vector<uint32_t> sievingPrimesFor(uint64_t high) {
+    uint64_t root = isqrt(high);
+    if (root < SMALL_PRIME_LIMIT) {
+        const std::vector<uint32_t>& small = smallPrimes();
+        return std::vector<uint32_t>(small.begin(),
+                                     std::upper_bound(small.begin(), small.end(), root));
+    }
+    return simpleSieve(root);
+}
+
+class WheelSegment {
+public:
+    WheelSegment(const std::vector<uint32_t>& primes, uint64_t base) : bits_(SEGMENT_BYTES) {
+        for (uint32_t p : primes) {
+            if (p < 7) {
+                continue;
+            }
+            uint64_t m = std::max<uint64_t>(p, (base + p - 1) / p);
+            while (wheelIndex()[m % WHEEL] == 0xFF) {
+                m++;
+            }
+            state_.push_back({p, p * m, wheelIndex()[m % WHEEL]});
+        }
+    }
     
-    for (uint64_t i = 2; i * i <= limit; ++i) {
-        if (isPrime[i]) {
-            for (uint64_t j = i * i; j <= limit; j += i) {
-                isPrime[j] = false;
+    void sieve(uint64_t base) {
+        base_ = base;
+        std::fill(bits_.begin(), bits_.end(), 0);
+        uint64_t end = base + SEGMENT_SPAN;
+        const uint8_t* index = wheelIndex();
+        
+        for (SievingPrime& s : state_) {
+            if (s.prime * s.prime >= end) {
+                break;
             }
+            uint64_t n = s.next;
+            uint32_t w = s.wheel;
+            while (n < end) {
+                uint64_t offset = n - base;
+                bits_[offset / WHEEL] |= static_cast<uint8_t>(1u << index[n % WHEEL]);
+                n += s.prime * WHEEL_GAPS[w];
+                w = (w + 1) & 7;
+            }
+            s.next = n;
+            s.wheel = w;
         }
     }
     
-    std::vector<uint64_t> primes;
-    for (uint64_t i = 2; i <= limit; ++i) {
-        if (isPrime[i]) {
-            primes.push_back(i);
+    template <typename Visit>
+    void emit(uint64_t low, uint64_t high, Visit&& visit) const {
+        for (size_t i = 0; i < SEGMENT_BYTES; ++i) {
+            uint32_t open = ~bits_[i] & 0xFFu;
+            uint64_t row = base_ + i * WHEEL;
+            if (row > high) {
+                return;
+            }
+            while (open != 0) {
+                int bit = __builtin_ctz(open);
+                open &= open - 1;
+                uint64_t n = row + WHEEL_RESIDUES[bit];
+                if (n > high) {
+                    return;
+                }
+                if (n >= low && n != 1) {
+                    visit(n);
+                }
+            }
         }
     }
+
+private:
+    struct SievingPrime {
+        uint64_t prime;
+        uint64_t next;
+        uint32_t wheel;
+    };
     
+    std::vector<uint8_t> bits_;
+    std::vector<SievingPrime> state_;
+    uint64_t base_ = 0;
+};
+
+template <typename Visit>
+static void visitWheelPrimes(uint64_t low, uint64_t high, Visit&& visit) {
+    for (uint64_t p : {2, 3, 5}) {
+        if (p >= low && p <= high) {
+            visit(p);
+        }
+    }
+}
+
+template <typename VisitChunk>
+static void sieveChunks(uint64_t low, uint64_t high, size_t threads, VisitChunk&& visitChunk) {
+    if (high > MAX_SIEVE_LIMIT) {
+        throw CryptoException("Sieve limit is too large");
+    }
+    
+    std::vector<uint32_t> primes = sievingPrimesFor(high);
+    uint64_t first = low / WHEEL * WHEEL;
+    uint64_t chunkSpan = SEGMENT_SPAN * SEGMENTS_PER_CHUNK;
+    uint64_t chunks = (high - first) / chunkSpan + 1;
+    
+    std::atomic<uint64_t> nextChunk{0};
+    auto worker = [&]() {
+        for (uint64_t c = nextChunk++; c < chunks; c = nextChunk++) {
+            uint64_t base = first + c * chunkSpan;
+            WheelSegment segment(primes, base);
+            for (uint64_t k = 0; k < SEGMENTS_PER_CHUNK && base <= high; ++k, base += SEGMENT_SPAN) {
+                segment.sieve(base);
+                visitChunk(c, segment);
+            }
+        }
+    };
+    
+    if (threads == 0) {
+        threads = std::max<size_t>(1, std::thread::hardware_concurrency());
+    }
+    threads = static_cast<size_t>(std::min<uint64_t>(threads, chunks));
+    if (threads <= 1) {
+        worker();
+        return;
+    }
+    
+    std::vector<std::thread> pool;
+    std::vector<std::exception_ptr> errors(threads);
+    for (size_t t = 0; t < threads; ++t) {
+        pool.emplace_back([&, t]() {
+            try {
+                worker();
+            } catch (...) {
+                errors[t] = std::current_exception();
+                nextChunk = chunks;
+            }
+        });
+    }
+    for (std::thread& thread : pool) {
+        thread.join();
+    }
+    for (const std::exception_ptr& error : errors) {
+        if (error) {
+            std::rethrow_exception(error);
+        }
+    }
+}
+
+const std::vector<uint32_t>& smallPrimes() {
+    static const std::vector<uint32_t> primes = simpleSieve(SMALL_PRIME_LIMIT - 1);
     return primes;
 }
 
+std::vector<uint64_t> sieveOfEratosthenes(uint64_t limit) {
+    if (limit < 2) return {};
+    
+    size_t threads = limit >= PARALLEL_SIEVE_THRESHOLD ? 0 : 1;
+    uint64_t chunks = limit / (SEGMENT_SPAN * SEGMENTS_PER_CHUNK) + 1;
+    std::vector<std::vector<uint64_t>> blocks(chunks);
+    sieveChunks(0, limit, threads, [&](uint64_t chunk, const WheelSegment& segment) {
+        std::vector<uint64_t>& block = blocks[chunk];
+        segment.emit(0, limit, [&](uint64_t p) { block.push_back(p); });
+    });
+    
+    std::vector<uint64_t> primes;
+    visitWheelPrimes(0, limit, [&](uint64_t p) { primes.push_back(p); });
+    for (const std::vector<uint64_t>& block : blocks) {
+        primes.insert(primes.end(), block.begin(), block.end());
+    }
+    return primes;
+}
+
+void forEachPrime(uint64_t low, uint64_t high, const std::function<void(uint64_t)>& visit) {
+    if (low > high) return;
+    
+    visitWheelPrimes(low, high, visit);
+    sieveChunks(low, high, 1, [&](uint64_t, const WheelSegment& segment) {
+        segment.emit(low, high, visit);
+    });
+}
+
+void forEachPrimeParallel(uint64_t low, uint64_t high,
+                          const std::function<void(const std::vector<uint64_t>&)>& visitBlock,
+                          size_t threads) {
+    if (low > high) return;
+    
+    std::vector<uint64_t> wheelPrimes;
+    visitWheelPrimes(low, high, [&](uint64_t p) { wheelPrimes.push_back(p); });
+    if (!wheelPrimes.empty()) {
+        visitBlock(wheelPrimes);
+    }
+    
+    sieveChunks(low, high, threads, [&](uint64_t, const WheelSegment& segment) {
+        std::vector<uint64_t> block;
+        segment.emit(low, high, [&](uint64_t p) { block.push_back(p); });
+        if (!block.empty()) {
+            visitBlock(block);
+        }
+    });
+}
+
+uint64_t countPrimes(uint64_t low, uint64_t high, size_t threads) {
+    if (low > high) return 0;
+    
+    std::atomic<uint64_t> total{0};
+    visitWheelPrimes(low, high, [&](uint64_t) { total++; });
+    sieveChunks(low, high, threads, [&](uint64_t, const WheelSegment& segment) {
+        uint64_t count = 0;
+        segment.emit(low, high, [&](uint64_t) { count++; });
+        total += count;
+    });
+    return total;
+}
+
+PrimeIterator::PrimeIterator(uint64_t start)
+    : segmentLow_(start / WHEEL * WHEEL), position_(0) {
+    visitWheelPrimes(start, 5, [&](uint64_t p) { buffer_.push_back(p); });
+    if (buffer_.empty()) {
+        fillSegment();
+    }
+    while (position_ < buffer_.size() && buffer_[position_] < start) {
+        position_++;
+    }
+}
+
+uint64_t PrimeIterator::next() {
+    while (position_ >= buffer_.size()) {
+        fillSegment();
+    }
+    return buffer_[position_++];
+}
+
+void PrimeIterator::fillSegment() {
+    uint64_t high = segmentLow_ + SEGMENT_SPAN - 1;
+    if (high > MAX_SIEVE_LIMIT) {
+        throw CryptoException("Prime iterator exhausted");
+    }
+    
+    uint64_t root = isqrt(high);
+    if (sievingPrimes_.empty() || sievingPrimes_.back() < root) {
+        uint64_t ahead = high <= MAX_SIEVE_LIMIT / 4 ? high * 4 : MAX_SIEVE_LIMIT;
+        sievingPrimes_ = sievingPrimesFor(std::max(ahead, SMALL_PRIME_LIMIT));
+    }
+    
+    buffer_.clear();
+    position_ = 0;
+    WheelSegment segment(sievingPrimes_, segmentLow_);
+    segment.sieve(segmentLow_);
+    segment.emit(0, high, [&](uint64_t p) { buffer_.push_back(p); });
+    segmentLow_ += SEGMENT_SPAN;
+}
+
 }
 }
 
@@ -1,20 +1,224 @@
-
 #include "../../include/crypto/math/random.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstring>
+#include <mutex>
+
+#if defined(__linux__)
+#include <sys/random.h>
+#elif defined(__APPLE__)
+#include <unistd.h>
+#else
 #include <random>
+#endif
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <pthread.h>
+#endif
 
 namespace crypto {
 namespace math {
 
-ByteArray randomBytes(size_t count) {
-    ByteArray result(count);
-    std::random_device rd;
-    std::mt19937 gen(rd());
-    std::uniform_int_distribution<> dis(0, 255);
+static inline uint32_t rotl32(uint32_t x, int n) {
+    return (x << n) | (x >> (32 - n));
+}
+
+static inline void quarterRound(uint32_t& a, uint32_t& b, uint32_t& c, uint32_t& d) {
+    a += b; d ^= a; d = rotl32(d, 16);
+    c += d; b ^= c; b = rotl32(b, 12);
+    a += b; d ^= a; d = rotl32(d, 8);
+    c += d; b ^= c; b = rotl32(b, 7);
+}
+
+static inline uint32_t loadLittleEndian(const Byte* in) {
+    return static_cast<uint32_t>(in[0]) | (static_cast<uint32_t>(in[1]) << 8) |
+           (static_cast<uint32_t>(in[2]) << 16) | (static_cast<uint32_t>(in[3]) << 24);
+}
+
+void chacha20Block(const uint32_t key[8], uint32_t counter, const uint32_t nonce[3], Byte out[64]) {
+    uint32_t input[16] = {
+        0x61707865, 0x3320646e, 0x79622d32, 0x6b206574,
+        key[0], key[1], key[2], key[3], key[4], key[5], key[6], key[7],
+        counter, nonce[0], nonce[1], nonce[2]
+    };
+    uint32_t x[16];
+    std::memcpy(x, input, sizeof(x));
+    
+    for (int round = 0; round < 10; ++round) {
+        quarterRound(x[0], x[4], x[8], x[12]);
+        quarterRound(x[1], x[5], x[9], x[13]);
+        quarterRound(x[2], x[6], x[10], x[14]);
+        quarterRound(x[3], x[7], x[11], x[15]);
+        quarterRound(x[0], x[5], x[10], x[15]);
+        quarterRound(x[1], x[6], x[11], x[12]);
+        quarterRound(x[2], x[7], x[8], x[13]);
+        quarterRound(x[3], x[4], x[9], x[14]);
+    }
+    
+    for (int i = 0; i < 16; ++i) {
+        uint32_t word = x[i] + input[i];
+        out[4 * i] = static_cast<Byte>(word);
+        out[4 * i + 1] = static_cast<Byte>(word >> 8);
+        out[4 * i + 2] = static_cast<Byte>(word >> 16);
+        out[4 * i + 3] = static_cast<Byte>(word >> 24);
+    }
+}
+
+namespace {
+
+constexpr size_t CHACHA_BLOCK_SIZE = 64;
+constexpr size_t CHACHA_BLOCKS_PER_REFILL = 64;
+constexpr size_t CHACHA_BUFFER_SIZE = CHACHA_BLOCK_SIZE * CHACHA_BLOCKS_PER_REFILL;
+constexpr size_t CHACHA_KEY_SIZE = 32;
+
+std::atomic<uint64_t> forkGeneration{1};
+
+#if defined(__unix__) || defined(__APPLE__)
+std::once_flag forkHandlerOnce;
+
+void onForkChild() {
+    forkGeneration.fetch_add(1, std::memory_order_relaxed);
+}
+#endif
+
+void systemEntropy(Byte* out, size_t count) {
+#if defined(__linux__)
+    while (count > 0) {
+        ssize_t got = getrandom(out, count, 0);
+        if (got < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            throw CryptoException("SecureRandom: getrandom failed");
+        }
+        out += got;
+        count -= static_cast<size_t>(got);
+    }
+#elif defined(__APPLE__)
+    // getentropy() serves at most 256 bytes per call.
+    while (count > 0) {
+        size_t chunk = std::min<size_t>(count, 256);
+        if (getentropy(out, chunk) != 0) {
+            throw CryptoException("SecureRandom: getentropy failed");
+        }
+        out += chunk;
+        count -= chunk;
+    }
+#else
+    std::random_device device;
+    while (count > 0) {
+        unsigned int word = device();
+        size_t chunk = std::min(count, sizeof(word));
+        std::memcpy(out, &word, chunk);
+        out += chunk;
+        count -= chunk;
+    }
+#endif
+}
+
+void wipe(void* data, size_t size) {
+    volatile Byte* bytes = static_cast<volatile Byte*>(data);
+    for (size_t i = 0; i < size; ++i) {
+        bytes[i] = 0;
+    }
+}
+
+struct ChaChaState {
+    uint32_t key[8];
+    Byte buffer[CHACHA_BUFFER_SIZE];
+    size_t position = CHACHA_BUFFER_SIZE;
+    uint64_t generation = 0;
+    
+    ~ChaChaState() {
+        wipe(key, sizeof(key));
+        wipe(buffer, sizeof(buffer));
+    }
     
-    for (size_t i = 0; i < count; ++i) {
-        result[i] = static_cast<Byte>(dis(gen));
+    void reseed() {
+#if defined(__unix__) || defined(__APPLE__)
+        std::call_once(forkHandlerOnce, [] {
+            pthread_atfork(nullptr, nullptr, onForkChild);
+        });
+#endif
+        
+        Byte seed[CHACHA_KEY_SIZE];
+        systemEntropy(seed, sizeof(seed));
+        for (size_t i = 0; i < 8; ++i) {
+            key[i] = loadLittleEndian(seed + 4 * i);
+        }
+        wipe(seed, sizeof(seed));
+        wipe(buffer, sizeof(buffer));
+        position = CHACHA_BUFFER_SIZE;
+        generation = forkGeneration.load(std::memory_order_relaxed);
+    }
+    
+    void refill() {
+        static const uint32_t nonce[3] = {0, 0, 0};
+        for (uint32_t block = 0; block < CHACHA_BLOCKS_PER_REFILL; ++block) {
+            chacha20Block(key, block, nonce, buffer + block * CHACHA_BLOCK_SIZE);
+        }
+        for (size_t i = 0; i < 8; ++i) {
+            key[i] = loadLittleEndian(buffer + 4 * i);
+        }
+        wipe(buffer, CHACHA_KEY_SIZE);
+        position = CHACHA_KEY_SIZE;
+    }
+    
+    void fill(Byte* out, size_t count) {
+        if (generation != forkGeneration.load(std::memory_order_relaxed)) {
+            reseed();
+        }
+        
+        while (count > 0) {
+            if (position == CHACHA_BUFFER_SIZE) {
+                refill();
+            }
+            size_t chunk = std::min(count, CHACHA_BUFFER_SIZE - position);
+            std::memcpy(out, buffer + position, chunk);
+            std::memset(buffer + position, 0, chunk);
+            position += chunk;
+            out += chunk;
+            count -= chunk;
+        }
+    }
+};
+
+thread_local ChaChaState chachaState;
+
+}
+
+void SecureRandom::fill(Byte* out, size_t count) {
+    chachaState.fill(out, count);
+}
+
+SecureRandom::result_type SecureRandom::operator()() {
+    Byte bytes[sizeof(result_type)];
+    fill(bytes, sizeof(bytes));
+    result_type value = 0;
+    for (size_t i = 0; i < sizeof(bytes); ++i) {
+        value |= static_cast<result_type>(bytes[i]) << (8 * i);
+    }
+    return value;
+}
+
+uint64_t SecureRandom::uniform(uint64_t bound) {
+    if (bound == 0) {
+        throw CryptoException("SecureRandom: bound must be positive");
     }
     
+    SecureRandom rng;
+    uint64_t limit = max() - max() % bound;
+    uint64_t value;
+    do {
+        value = rng();
+    } while (value >= limit);
+    return value % bound;
+}
+
+ByteArray randomBytes(size_t count) {
+    ByteArray result(count);
+    SecureRandom::fill(result.data(), count);
     return result;
 }
 
@@ -24,4 +228,3 @@ Key randomKey(size_t size) {
 
 }
 }
-
@@ -1,4 +1,5 @@
 #include "../../include/crypto/modes/cbc.hpp"
+#include "../../include/crypto/modes/block_ranges.hpp"
 #include "../../include/crypto/core/utils.hpp"
 #include "../../include/crypto/math/random.hpp"
 #include <stdexcept>
@@ -17,6 +18,9 @@ CBCMode::CBCMode(std::shared_ptr<IBlockCipher> cipher,
     }
     
     blockSize_ = cipher_->blockSize();
+    if (blockSize_ > MAX_BLOCK_SIZE) {
+        throw CryptoException("Cipher block size exceeds MAX_BLOCK_SIZE");
+    }
     generateRandomIV();
 }
 
@@ -26,6 +30,9 @@ void CBCMode::setCipher(std::shared_ptr<IBlockCipher> cipher) {
     }
     cipher_ = std::move(cipher);
     blockSize_ = cipher_->blockSize();
+    if (blockSize_ > MAX_BLOCK_SIZE) {
+        throw CryptoException("Cipher block size exceeds MAX_BLOCK_SIZE");
+    }
     generateRandomIV();
 }
 
@@ -34,6 +41,10 @@ void CBCMode::setPadding(std::unique_ptr<IPadding> padding) {
     usePadding_ = (padding_ != nullptr);
 }
 
+void CBCMode::setThreadPool(std::shared_ptr<ThreadPool> pool) {
+    pool_ = std::move(pool);
+}
+
 void CBCMode::setIV(const ByteArray& iv) {
     if (iv.size() != blockSize_) {
         throw CryptoException("IV size must equal block size");
@@ -50,16 +61,13 @@ void CBCMode::generateRandomIV() {
 }
 
 ByteArray CBCMode::encrypt(const ByteArray& plaintext) {
-    ByteArray data = plaintext;
-    
-    if (usePadding_) {
-        data = padding_->pad(data, blockSize_);
-    } else if (data.size() % blockSize_ != 0) {
+    if (!usePadding_ && plaintext.size() % blockSize_ != 0) {
         throw CryptoException("Data size must be multiple of block size when padding is disabled");
     }
     
-    ByteArray ciphertext(data.size());
-    encrypt(data.data(), ciphertext.data(), data.size());
+    ByteArray ciphertext(plaintext.size() + (usePadding_ ? blockSize_ : 0));
+    std::copy(plaintext.begin(), plaintext.end(), ciphertext.begin());
+    ciphertext.resize(encryptInPlace(ciphertext.data(), plaintext.size(), ciphertext.size()));
     return ciphertext;
 }
 
@@ -68,13 +76,8 @@ ByteArray CBCMode::decrypt(const ByteArray& ciphertext) {
         throw CryptoException("Ciphertext size must be multiple of block size");
     }
     
-    ByteArray plaintext(ciphertext.size());
-    decrypt(ciphertext.data(), plaintext.data(), ciphertext.size());
-    
-    if (usePadding_) {
-        plaintext = padding_->unpad(plaintext);
-    }
-    
+    ByteArray plaintext = ciphertext;
+    plaintext.resize(decryptInPlace(plaintext.data(), plaintext.size()));
     return plaintext;
 }
 
@@ -83,40 +86,117 @@ void CBCMode::encrypt(const Byte* input, Byte* output, size_t length) {
         throw CryptoException("Input length must be multiple of block size");
     }
     
-    size_t numBlocks = length / blockSize_;
-    ByteArray currentIV = iv_;
-    
-    for (size_t i = 0; i < numBlocks; ++i) {
+    Byte chain[MAX_BLOCK_SIZE];
+    std::memcpy(chain, iv_.data(), blockSize_);
+    encryptChained(chain, input, output, length / blockSize_);
+}
+
+void CBCMode::encryptChained(Byte* chain, const Byte* input, Byte* output, size_t blocks) const {
+    for (size_t i = 0; i < blocks; ++i) {
         const Byte* blockInput = input + i * blockSize_;
         Byte* blockOutput = output + i * blockSize_;
-        ByteArray xored(blockSize_);
+        
+        utils::xorBlocks(blockInput, chain, chain, blockSize_);
+        
+        cipher_->encryptBlock(chain, blockOutput);
+        
+        std::memcpy(chain, blockOutput, blockSize_);
+    }
+}
 
-        utils::xorBlocks(blockInput, currentIV.data(), xored.data(), blockSize_);
+void CBCMode::decryptChained(const Byte* input, Byte* output, size_t blocks,
+                             const Byte* previous) const {
+    Byte chain[(BATCH_BLOCKS + 1) * MAX_BLOCK_SIZE];
+    Byte decrypted[BATCH_BLOCKS * MAX_BLOCK_SIZE];
+    std::memcpy(chain, previous, blockSize_);
+    
+    while (blocks > 0) {
+        size_t batch = std::min(BATCH_BLOCKS, blocks);
+        size_t bytes = batch * blockSize_;
+        std::memcpy(chain + blockSize_, input, bytes);
         
-        cipher_->encryptBlock(xored.data(), blockOutput);
+        cipher_->decryptBlocks(chain + blockSize_, decrypted, batch);
+        utils::xorBlocks(decrypted, chain, output, bytes);
         
-        currentIV.assign(blockOutput, blockOutput + blockSize_);
+        std::memcpy(chain, chain + bytes, blockSize_);
+        input += bytes;
+        output += bytes;
+        blocks -= batch;
     }
 }
 
+void CBCMode::decryptWindow(const Byte* input, Byte* output, size_t blocks,
+                            const Byte* previous) const {
+    runChainedRanges(pool_.get(), input, previous, blockSize_, blocks,
+                     [&](size_t first, size_t count, const Byte* chain) {
+        size_t start = first * blockSize_;
+        decryptChained(input + start, output + start, count, chain);
+    });
+}
+
 void CBCMode::decrypt(const Byte* input, Byte* output, size_t length) {
     if (length % blockSize_ != 0) {
         throw CryptoException("Input length must be multiple of block size");
     }
     
-    size_t numBlocks = length / blockSize_;
-    ByteArray previousBlock = iv_;
+    decryptWindow(input, output, length / blockSize_, iv_.data());
+}
+
+ByteArray CBCMode::decryptRange(const ByteArray& ciphertext, uint64_t blockOffset,
+                                size_t blocks) const {
+    uint64_t available = ciphertext.size() / blockSize_;
+    if (blockOffset > available || blocks > available - blockOffset) {
+        throw CryptoException("Ciphertext range exceeds input");
+    }
+    
+    size_t start = static_cast<size_t>(blockOffset) * blockSize_;
+    const Byte* previous = blockOffset == 0 ? iv_.data() : ciphertext.data() + start - blockSize_;
     
-    for (size_t i = 0; i < numBlocks; ++i) {
-        const Byte* blockInput = input + i * blockSize_;
-        Byte* blockOutput = output + i * blockSize_;
-        ByteArray decrypted(blockSize_);
-        
-        cipher_->decryptBlock(blockInput, decrypted.data());
-        
-        utils::xorBlocks(decrypted.data(), previousBlock.data(), blockOutput, blockSize_);
-        
-        previousBlock.assign(blockInput, blockInput + blockSize_);
+    ByteArray plaintext(blocks * blockSize_);
+    decryptWindow(ciphertext.data() + start, plaintext.data(), blocks, previous);
+    return plaintext;
+}
+
+ByteArray CBCMode::decryptRange(std::istream& ciphertext, uint64_t blockOffset,
+                                size_t blocks) const {
+    // A previous out-of-range read leaves failbit/eofbit set, which would make seekg fail.
+    ciphertext.clear();
+    Byte previous[MAX_BLOCK_SIZE];
+    if (blockOffset == 0) {
+        ciphertext.seekg(0);
+        std::memcpy(previous, iv_.data(), blockSize_);
+    } else {
+        ciphertext.seekg(static_cast<std::streamoff>((blockOffset - 1) * blockSize_));
+        ciphertext.read(reinterpret_cast<char*>(previous), blockSize_);
+    }
+    
+    ByteArray plaintext(blocks * blockSize_);
+    ciphertext.read(reinterpret_cast<char*>(plaintext.data()), plaintext.size());
+    if (!ciphertext) {
+        throw CryptoException("Ciphertext range exceeds input");
+    }
+    
+    decryptWindow(plaintext.data(), plaintext.data(), blocks, previous);
+    return plaintext;
+}
+
+void CBCMode::streamStart(bool) {
+    chain_ = iv_;
+}
+
+void CBCMode::streamProcess(bool encrypting, const Byte* input, Byte* output, size_t length) {
+    if (length % blockSize_ != 0) {
+        throw CryptoException("Input length must be multiple of block size");
+    }
+    
+    size_t blocks = length / blockSize_;
+    if (encrypting) {
+        encryptChained(chain_.data(), input, output, blocks);
+    } else if (blocks > 0) {
+        Byte last[MAX_BLOCK_SIZE];
+        std::memcpy(last, input + length - blockSize_, blockSize_);
+        decryptWindow(input, output, blocks, chain_.data());
+        std::memcpy(chain_.data(), last, blockSize_);
     }
 }
 
@@ -1,4 +1,5 @@
 #include "../../include/crypto/modes/cfb.hpp"
+#include "../../include/crypto/modes/block_ranges.hpp"
 #include "../../include/crypto/core/utils.hpp"
 #include "../../include/crypto/math/random.hpp"
 #include <stdexcept>
@@ -18,6 +19,9 @@ CFBMode::CFBMode(std::shared_ptr<IBlockCipher> cipher,
     }
     
     blockSize_ = cipher_->blockSize();
+    if (blockSize_ > MAX_BLOCK_SIZE) {
+        throw CryptoException("Cipher block size exceeds MAX_BLOCK_SIZE");
+    }
     
     if (segmentSizeBits == 0 || segmentSizeBits > blockSize_ * 8) {
         segmentSize_ = blockSize_;
@@ -35,6 +39,9 @@ void CFBMode::setCipher(std::shared_ptr<IBlockCipher> cipher) {
     }
     cipher_ = std::move(cipher);
     blockSize_ = cipher_->blockSize();
+    if (blockSize_ > MAX_BLOCK_SIZE) {
+        throw CryptoException("Cipher block size exceeds MAX_BLOCK_SIZE");
+    }
     generateRandomIV();
     feedback_ = iv_;
 }
@@ -44,6 +51,10 @@ void CFBMode::setPadding(std::unique_ptr<IPadding> padding) {
     usePadding_ = (padding_ != nullptr);
 }
 
+void CFBMode::setThreadPool(std::shared_ptr<ThreadPool> pool) {
+    pool_ = std::move(pool);
+}
+
 void CFBMode::setIV(const ByteArray& iv) {
     if (iv.size() != blockSize_) {
         throw CryptoException("IV size must equal block size");
@@ -62,80 +73,173 @@ void CFBMode::generateRandomIV() {
 }
 
 ByteArray CFBMode::encrypt(const ByteArray& plaintext) {
-    ByteArray data = plaintext;
-    
-    if (usePadding_) {
-        data = padding_->pad(data, blockSize_);
-    }
-    
-    ByteArray ciphertext(data.size());
-    encrypt(data.data(), ciphertext.data(), data.size());
+    ByteArray ciphertext(plaintext.size() + (usePadding_ ? blockSize_ : 0));
+    std::copy(plaintext.begin(), plaintext.end(), ciphertext.begin());
+    ciphertext.resize(encryptInPlace(ciphertext.data(), plaintext.size(), ciphertext.size()));
     return ciphertext;
 }
 
 ByteArray CFBMode::decrypt(const ByteArray& ciphertext) {
-    ByteArray plaintext(ciphertext.size());
-    decrypt(ciphertext.data(), plaintext.data(), ciphertext.size());
-    
-    if (usePadding_) {
-        plaintext = padding_->unpad(plaintext);
-    }
-    
+    ByteArray plaintext = ciphertext;
+    plaintext.resize(decryptInPlace(plaintext.data(), plaintext.size()));
     return plaintext;
 }
 
+void CFBMode::shiftFeedback(const Byte* segment) {
+    std::memmove(feedback_.data(), feedback_.data() + segmentSize_, blockSize_ - segmentSize_);
+    std::memcpy(feedback_.data() + blockSize_ - segmentSize_, segment, segmentSize_);
+}
+
 void CFBMode::encrypt(const Byte* input, Byte* output, size_t length) {
     size_t processed = 0;
     
+    Byte keystream[MAX_BLOCK_SIZE];
+    
     while (processed < length) {
-        ByteArray encrypted(blockSize_);
-        cipher_->encryptBlock(feedback_.data(), encrypted.data());
+        cipher_->encryptBlock(feedback_.data(), keystream);
         
         size_t toProcess = std::min(segmentSize_, length - processed);
         
         for (size_t i = 0; i < toProcess; ++i) {
-            output[processed + i] = input[processed + i] ^ encrypted[i];
+            output[processed + i] = input[processed + i] ^ keystream[i];
         }
         
-        if (segmentSize_ == blockSize_) {
-            feedback_.assign(output + processed, output + processed + blockSize_);
-        } else {
-            std::memmove(feedback_.data(), feedback_.data() + segmentSize_, 
-                        blockSize_ - segmentSize_);
-            std::memcpy(feedback_.data() + blockSize_ - segmentSize_, 
-                       output + processed, segmentSize_);
+        if (toProcess == segmentSize_) {
+            shiftFeedback(output + processed);
         }
         
         processed += toProcess;
     }
 }
 
+void CFBMode::decryptChained(const Byte* input, Byte* output, size_t blocks,
+                             const Byte* previous) const {
+    Byte chain[(BATCH_BLOCKS + 1) * MAX_BLOCK_SIZE];
+    Byte keystream[BATCH_BLOCKS * MAX_BLOCK_SIZE];
+    std::memcpy(chain, previous, blockSize_);
+    
+    while (blocks > 0) {
+        size_t batch = std::min(BATCH_BLOCKS, blocks);
+        size_t bytes = batch * blockSize_;
+        std::memcpy(chain + blockSize_, input, bytes);
+        
+        cipher_->encryptBlocks(chain, keystream, batch);
+        utils::xorBlocks(keystream, chain + blockSize_, output, bytes);
+        
+        std::memcpy(chain, chain + bytes, blockSize_);
+        input += bytes;
+        output += bytes;
+        blocks -= batch;
+    }
+}
+
+void CFBMode::decryptWindow(const Byte* input, Byte* output, size_t length,
+                            const Byte* previous) const {
+    size_t blocks = length / blockSize_;
+    size_t tail = length % blockSize_;
+    
+    Byte feedback[MAX_BLOCK_SIZE];
+    if (tail != 0) {
+        std::memcpy(feedback, blocks == 0 ? previous : input + (blocks - 1) * blockSize_, blockSize_);
+    }
+    
+    runChainedRanges(pool_.get(), input, previous, blockSize_, blocks,
+                     [&](size_t first, size_t count, const Byte* chain) {
+        size_t start = first * blockSize_;
+        decryptChained(input + start, output + start, count, chain);
+    });
+    
+    if (tail != 0) {
+        Byte keystream[MAX_BLOCK_SIZE];
+        cipher_->encryptBlock(feedback, keystream);
+        utils::xorBlocks(keystream, input + blocks * blockSize_, output + blocks * blockSize_, tail);
+    }
+}
+
 void CFBMode::decrypt(const Byte* input, Byte* output, size_t length) {
     size_t processed = 0;
     
+    if (segmentSize_ == blockSize_ && length >= blockSize_) {
+        size_t blocks = length / blockSize_;
+        processed = blocks * blockSize_;
+        
+        Byte last[MAX_BLOCK_SIZE];
+        std::memcpy(last, input + processed - blockSize_, blockSize_);
+        decryptWindow(input, output, processed, feedback_.data());
+        std::memcpy(feedback_.data(), last, blockSize_);
+    }
+    
+    Byte keystream[MAX_BLOCK_SIZE];
+    
     while (processed < length) {
-        ByteArray encrypted(blockSize_);
-        cipher_->encryptBlock(feedback_.data(), encrypted.data());
+        cipher_->encryptBlock(feedback_.data(), keystream);
         
         size_t toProcess = std::min(segmentSize_, length - processed);
         
-        for (size_t i = 0; i < toProcess; ++i) {
-            output[processed + i] = input[processed + i] ^ encrypted[i];
+        if (toProcess == segmentSize_) {
+            shiftFeedback(input + processed);
         }
         
-        if (segmentSize_ == blockSize_) {
-            feedback_.assign(input + processed, input + processed + blockSize_);
-        } else {
-            std::memmove(feedback_.data(), feedback_.data() + segmentSize_, 
-                        blockSize_ - segmentSize_);
-            std::memcpy(feedback_.data() + blockSize_ - segmentSize_, 
-                       input + processed, segmentSize_);
+        for (size_t i = 0; i < toProcess; ++i) {
+            output[processed + i] = input[processed + i] ^ keystream[i];
         }
         
         processed += toProcess;
     }
 }
 
+ByteArray CFBMode::decryptRange(const ByteArray& ciphertext, uint64_t blockOffset,
+                                size_t blocks) const {
+    if (segmentSize_ != blockSize_) {
+        throw CryptoException("Range decryption requires full-block CFB segments");
+    }
+    
+    uint64_t available = (ciphertext.size() + blockSize_ - 1) / blockSize_;
+    if (blockOffset > available || blocks > available - blockOffset) {
+        throw CryptoException("Ciphertext range exceeds input");
+    }
+    
+    size_t start = static_cast<size_t>(blockOffset) * blockSize_;
+    size_t length = std::min(blocks * blockSize_, ciphertext.size() - start);
+    const Byte* previous = blockOffset == 0 ? iv_.data() : ciphertext.data() + start - blockSize_;
+    
+    ByteArray plaintext(length);
+    decryptWindow(ciphertext.data() + start, plaintext.data(), length, previous);
+    return plaintext;
+}
+
+ByteArray CFBMode::decryptRange(std::istream& ciphertext, uint64_t blockOffset,
+                                size_t blocks) const {
+    if (segmentSize_ != blockSize_) {
+        throw CryptoException("Range decryption requires full-block CFB segments");
+    }
+    
+    // A previous out-of-range read leaves failbit/eofbit set, which would make seekg fail.
+    ciphertext.clear();
+    Byte previous[MAX_BLOCK_SIZE];
+    if (blockOffset == 0) {
+        ciphertext.seekg(0);
+        std::memcpy(previous, iv_.data(), blockSize_);
+    } else {
+        ciphertext.seekg(static_cast<std::streamoff>((blockOffset - 1) * blockSize_));
+        ciphertext.read(reinterpret_cast<char*>(previous), blockSize_);
+        if (!ciphertext) {
+            throw CryptoException("Ciphertext range exceeds input");
+        }
+    }
+    
+    ByteArray plaintext(blocks * blockSize_);
+    ciphertext.read(reinterpret_cast<char*>(plaintext.data()), plaintext.size());
+    size_t length = static_cast<size_t>(ciphertext.gcount());
+    if ((length + blockSize_ - 1) / blockSize_ < blocks) {
+        throw CryptoException("Ciphertext range exceeds input");
+    }
+    
+    plaintext.resize(length);
+    decryptWindow(plaintext.data(), plaintext.data(), length, previous);
+    return plaintext;
+}
+
 void CFBMode::reset() {
     feedback_ = iv_;
 }
@@ -1,4 +1,5 @@
 #include "../../include/crypto/modes/ctr.hpp"
+#include "../../include/crypto/modes/block_ranges.hpp"
 #include "../../include/crypto/core/utils.hpp"
 #include "../../include/crypto/math/random.hpp"
 #include <stdexcept>
@@ -11,7 +12,7 @@ CTRMode::CTRMode(std::shared_ptr<IBlockCipher> cipher,
                  std::unique_ptr<IPadding> padding)
     : cipher_(std::move(cipher))
     , padding_(std::move(padding))
-    , counter_(0)
+    , position_(0)
     , usePadding_(padding_ != nullptr) {
     
     if (!cipher_) {
@@ -19,6 +20,9 @@ CTRMode::CTRMode(std::shared_ptr<IBlockCipher> cipher,
     }
     
     blockSize_ = cipher_->blockSize();
+    if (blockSize_ > MAX_BLOCK_SIZE) {
+        throw CryptoException("Cipher block size exceeds MAX_BLOCK_SIZE");
+    }
     generateRandomIV();
 }
 
@@ -28,6 +32,9 @@ void CTRMode::setCipher(std::shared_ptr<IBlockCipher> cipher) {
     }
     cipher_ = std::move(cipher);
     blockSize_ = cipher_->blockSize();
+    if (blockSize_ > MAX_BLOCK_SIZE) {
+        throw CryptoException("Cipher block size exceeds MAX_BLOCK_SIZE");
+    }
     generateRandomIV();
 }
 
@@ -36,6 +43,10 @@ void CTRMode::setPadding(std::unique_ptr<IPadding> padding) {
     usePadding_ = (padding_ != nullptr);
 }
 
+void CTRMode::setThreadPool(std::shared_ptr<ThreadPool> pool) {
+    pool_ = std::move(pool);
+}
+
 void CTRMode::setIV(const ByteArray& iv) {
     if (iv.size() > blockSize_) {
         throw CryptoException("IV/nonce too large for block size");
@@ -44,7 +55,7 @@ void CTRMode::setIV(const ByteArray& iv) {
     nonce_.resize(blockSize_);
     std::fill(nonce_.begin(), nonce_.end(), 0);
     std::copy(iv.begin(), iv.end(), nonce_.begin());
-    counter_ = 0;
+    position_ = 0;
 }
 
 ByteArray CTRMode::getIV() const {
@@ -55,78 +66,99 @@ void CTRMode::generateRandomIV() {
     size_t nonceSize = blockSize_ / 2;
     nonce_ = math::randomBytes(nonceSize);
     nonce_.resize(blockSize_, 0);
-    counter_ = 0;
+    position_ = 0;
 }
 
-void CTRMode::incrementCounter() {
-    ++counter_;
-    if (counter_ == 0) {
-        for (size_t i = blockSize_ - 1; i >= blockSize_ / 2; --i) {
-            if (++nonce_[i] != 0) break;
-        }
+void CTRMode::counterBlock(uint64_t index, Byte* block) const {
+    std::memcpy(block, nonce_.data(), blockSize_);
+    
+    uint64_t carry = index;
+    for (size_t i = blockSize_; i > 0 && carry != 0; --i) {
+        uint64_t sum = static_cast<uint64_t>(block[i - 1]) + (carry & 0xFF);
+        block[i - 1] = static_cast<Byte>(sum);
+        carry = (carry >> 8) + (sum >> 8);
     }
 }
 
-void CTRMode::getCounterBlock(Byte* block) {
-    std::memcpy(block, nonce_.data(), blockSize_);
+void CTRMode::processBlocks(uint64_t firstBlock, const Byte* input, Byte* output,
+                            size_t length) const {
+    Byte counters[BATCH_BLOCKS * MAX_BLOCK_SIZE];
+    Byte keystream[BATCH_BLOCKS * MAX_BLOCK_SIZE];
     
-    uint64_t tempCounter = counter_;
-    for (size_t i = 0; i < sizeof(uint64_t) && i < blockSize_; ++i) {
-        block[blockSize_ - 1 - i] |= (tempCounter & 0xFF);
-        tempCounter >>= 8;
+    size_t processed = 0;
+    while (processed < length) {
+        size_t blocks = std::min(BATCH_BLOCKS, (length - processed + blockSize_ - 1) / blockSize_);
+        for (size_t b = 0; b < blocks; ++b) {
+            counterBlock(firstBlock + b, counters + b * blockSize_);
+        }
+        cipher_->encryptBlocks(counters, keystream, blocks);
+        
+        size_t toProcess = std::min(blocks * blockSize_, length - processed);
+        for (size_t i = 0; i < toProcess; ++i) {
+            output[processed + i] = input[processed + i] ^ keystream[i];
+        }
+        
+        processed += toProcess;
+        firstBlock += blocks;
     }
 }
 
 ByteArray CTRMode::encrypt(const ByteArray& plaintext) {
-    ByteArray data = plaintext;
-    
-    if (usePadding_) {
-        data = padding_->pad(data, blockSize_);
-    }
-    
-    ByteArray ciphertext(data.size());
-    encrypt(data.data(), ciphertext.data(), data.size());
+    ByteArray ciphertext(plaintext.size() + (usePadding_ ? blockSize_ : 0));
+    std::copy(plaintext.begin(), plaintext.end(), ciphertext.begin());
+    ciphertext.resize(encryptInPlace(ciphertext.data(), plaintext.size(), ciphertext.size()));
     return ciphertext;
 }
 
 ByteArray CTRMode::decrypt(const ByteArray& ciphertext) {
-    ByteArray plaintext(ciphertext.size());
-    decrypt(ciphertext.data(), plaintext.data(), ciphertext.size());
-    
-    if (usePadding_) {
-        plaintext = padding_->unpad(plaintext);
-    }
-    
+    ByteArray plaintext = ciphertext;
+    plaintext.resize(decryptInPlace(plaintext.data(), plaintext.size()));
     return plaintext;
 }
 
-void CTRMode::encrypt(const Byte* input, Byte* output, size_t length) {
-    size_t processed = 0;
+void CTRMode::process(uint64_t offset, const Byte* input, Byte* output, size_t length) const {
+    uint64_t first = offset / blockSize_;
+    size_t skip = static_cast<size_t>(offset % blockSize_);
     
-    while (processed < length) {
-        ByteArray counterBlock(blockSize_);
-        getCounterBlock(counterBlock.data());
-        
-        ByteArray keystream(blockSize_);
-        cipher_->encryptBlock(counterBlock.data(), keystream.data());
+    if (skip != 0 && length > 0) {
+        Byte counter[MAX_BLOCK_SIZE];
+        Byte keystream[MAX_BLOCK_SIZE];
+        counterBlock(first, counter);
+        cipher_->encryptBlock(counter, keystream);
         
-        size_t toProcess = std::min(blockSize_, length - processed);
-        
-        for (size_t i = 0; i < toProcess; ++i) {
-            output[processed + i] = input[processed + i] ^ keystream[i];
+        size_t head = std::min(blockSize_ - skip, length);
+        for (size_t i = 0; i < head; ++i) {
+            output[i] = input[i] ^ keystream[skip + i];
         }
-        
-        processed += toProcess;
-        incrementCounter();
+        input += head;
+        output += head;
+        length -= head;
+        first++;
     }
+    
+    size_t blocks = (length + blockSize_ - 1) / blockSize_;
+    runBlockRanges(pool_.get(), blocks, [&](size_t firstBlock, size_t count) {
+        size_t start = firstBlock * blockSize_;
+        size_t bytes = std::min(count * blockSize_, length - start);
+        processBlocks(first + firstBlock, input + start, output + start, bytes);
+    });
+}
+
+void CTRMode::encrypt(const Byte* input, Byte* output, size_t length) {
+    process(position_, input, output, length);
+    position_ += length;
 }
 
 void CTRMode::decrypt(const Byte* input, Byte* output, size_t length) {
     encrypt(input, output, length);
 }
 
+void CTRMode::seek(uint64_t byteOffset) {
+    position_ = byteOffset;
+}
+
 void CTRMode::reset() {
-    counter_ = 0;
+    position_ = 0;
 }
 
 }
\ No newline at end of file
@@ -1,4 +1,5 @@
 #include "../../include/crypto/modes/ecb.hpp"
+#include "../../include/crypto/modes/block_ranges.hpp"
 #include "../../include/crypto/core/utils.hpp"
 #include "../../include/crypto/math/random.hpp"
 #include <stdexcept>
@@ -32,17 +33,18 @@ void ECBMode::setPadding(std::unique_ptr<IPadding> padding) {
     usePadding_ = (padding_ != nullptr);
 }
 
+void ECBMode::setThreadPool(std::shared_ptr<ThreadPool> pool) {
+    pool_ = std::move(pool);
+}
+
 ByteArray ECBMode::encrypt(const ByteArray& plaintext) {
-    ByteArray data = plaintext;
-    
-    if (usePadding_) {
-        data = padding_->pad(data, blockSize_);
-    } else if (data.size() % blockSize_ != 0) {
+    if (!usePadding_ && plaintext.size() % blockSize_ != 0) {
         throw CryptoException("Data size must be multiple of block size when padding is disabled");
     }
     
-    ByteArray ciphertext(data.size());
-    encrypt(data.data(), ciphertext.data(), data.size());
+    ByteArray ciphertext(plaintext.size() + (usePadding_ ? blockSize_ : 0));
+    std::copy(plaintext.begin(), plaintext.end(), ciphertext.begin());
+    ciphertext.resize(encryptInPlace(ciphertext.data(), plaintext.size(), ciphertext.size()));
     return ciphertext;
 }
 
@@ -51,13 +53,8 @@ ByteArray ECBMode::decrypt(const ByteArray& ciphertext) {
         throw CryptoException("Ciphertext size must be multiple of block size");
     }
     
-    ByteArray plaintext(ciphertext.size());
-    decrypt(ciphertext.data(), plaintext.data(), ciphertext.size());
-    
-    if (usePadding_) {
-        plaintext = padding_->unpad(plaintext);
-    }
-    
+    ByteArray plaintext = ciphertext;
+    plaintext.resize(decryptInPlace(plaintext.data(), plaintext.size()));
     return plaintext;
 }
 
@@ -66,13 +63,10 @@ void ECBMode::encrypt(const Byte* input, Byte* output, size_t length) {
         throw CryptoException("Input length must be multiple of block size");
     }
     
-    size_t numBlocks = length / blockSize_;
-    
-    for (size_t i = 0; i < numBlocks; ++i) {
-        const Byte* blockInput = input + i * blockSize_;
-        Byte* blockOutput = output + i * blockSize_;
-        cipher_->encryptBlock(blockInput, blockOutput);
-    }
+    runBlockRanges(pool_.get(), length / blockSize_, [&](size_t first, size_t count) {
+        size_t start = first * blockSize_;
+        cipher_->encryptBlocks(input + start, output + start, count);
+    });
 }
 
 void ECBMode::decrypt(const Byte* input, Byte* output, size_t length) {
@@ -80,13 +74,10 @@ void ECBMode::decrypt(const Byte* input, Byte* output, size_t length) {
         throw CryptoException("Input length must be multiple of block size");
     }
     
-    size_t numBlocks = length / blockSize_;
-    
-    for (size_t i = 0; i < numBlocks; ++i) {
-        const Byte* blockInput = input + i * blockSize_;
-        Byte* blockOutput = output + i * blockSize_;
-        cipher_->decryptBlock(blockInput, blockOutput);
-    }
+    runBlockRanges(pool_.get(), length / blockSize_, [&](size_t first, size_t count) {
+        size_t start = first * blockSize_;
+        cipher_->decryptBlocks(input + start, output + start, count);
+    });
 }
 
 }
\ No newline at end of file
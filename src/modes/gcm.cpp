@@ -0,0 +1,227 @@
+#include "../../include/crypto/modes/gcm.hpp"
+#include "../../include/crypto/core/endianness.hpp"
+#include "../../include/crypto/math/random.hpp"
+#include <algorithm>
+#include <cstring>
+
+namespace crypto {
+
+namespace {
+
+const uint64_t MAX_MESSAGE_SIZE = (uint64_t(1) << 36) - 32;
+
+bool tagsEqual(const Byte* a, const Byte* b, size_t length) {
+    Byte diff = 0;
+    for (size_t i = 0; i < length; ++i) {
+        diff |= a[i] ^ b[i];
+    }
+    return diff == 0;
+}
+
+}
+
+GCMMode::GCMMode(std::shared_ptr<IBlockCipher> cipher,
+                 std::unique_ptr<IPadding>)
+    : cipher_(std::move(cipher))
+    , hardwareGHash_(true)
+    , ivUsed_(false) {
+    
+    if (!cipher_) {
+        throw CryptoException("Cipher cannot be null");
+    }
+    
+    bindCipher();
+    generateRandomIV();
+}
+
+void GCMMode::setCipher(std::shared_ptr<IBlockCipher> cipher) {
+    if (!cipher) {
+        throw CryptoException("Cipher cannot be null");
+    }
+    cipher_ = std::move(cipher);
+    bindCipher();
+    generateRandomIV();
+}
+
+void GCMMode::bindCipher() {
+    if (cipher_->blockSize() != GHash::BLOCK_SIZE) {
+        throw CryptoException("GCM requires a 128-bit block cipher");
+    }
+    ghash_.reset();
+}
+
+void GCMMode::setPadding(std::unique_ptr<IPadding>) {
+}
+
+void GCMMode::setIV(const ByteArray& iv) {
+    if (iv.empty()) {
+        throw CryptoException("GCM IV cannot be empty");
+    }
+    iv_ = iv;
+    ivUsed_ = false;
+}
+
+ByteArray GCMMode::getIV() const {
+    return iv_;
+}
+
+void GCMMode::generateRandomIV() {
+    iv_ = math::randomBytes(NONCE_SIZE);
+    ivUsed_ = false;
+}
+
+void GCMMode::setAAD(const ByteArray& aad) {
+    aad_ = aad;
+}
+
+void GCMMode::setTag(const ByteArray& tag) {
+    if (tag.size() != TAG_SIZE) {
+        throw CryptoException("GCM tag must be 16 bytes");
+    }
+    expectedTag_ = tag;
+}
+
+void GCMMode::setHardwareGHash(bool enabled) {
+    hardwareGHash_ = enabled;
+    ghash_.reset();
+}
+
+bool GCMMode::usesHardwareGHash() const {
+    return hardwareGHash_ && GHash::hardwareAvailable();
+}
+
+void GCMMode::prepareHash() {
+    Byte hashKey[GHash::BLOCK_SIZE] = {};
+    cipher_->encryptBlock(hashKey, hashKey);
+    
+    if (!ghash_ || std::memcmp(hashKey, hashKey_, GHash::BLOCK_SIZE) != 0) {
+        std::memcpy(hashKey_, hashKey, GHash::BLOCK_SIZE);
+        ghash_ = std::make_unique<GHash>(hashKey_, hardwareGHash_);
+    }
+}
+
+void GCMMode::initialCounter(Byte* counter) {
+    if (iv_.size() == NONCE_SIZE) {
+        std::memcpy(counter, iv_.data(), NONCE_SIZE);
+        endianness::uint32ToBytesBE(1, counter + NONCE_SIZE);
+        return;
+    }
+    
+    Byte lengths[GHash::BLOCK_SIZE] = {};
+    endianness::uint64ToBytesBE(static_cast<uint64_t>(iv_.size()) * 8, lengths + 8);
+    ghash_->reset();
+    ghash_->updatePadded(iv_.data(), iv_.size());
+    ghash_->update(lengths, 1);
+    ghash_->digest(counter);
+}
+
+void GCMMode::process(bool encrypting, const Byte* input, Byte* output, size_t length) {
+    if (static_cast<uint64_t>(length) > MAX_MESSAGE_SIZE) {
+        throw CryptoException("GCM message too long");
+    }
+    
+    prepareHash();
+    Byte j0[GHash::BLOCK_SIZE];
+    initialCounter(j0);
+    
+    ghash_->reset();
+    ghash_->updatePadded(aad_.data(), aad_.size());
+    
+    Byte counters[BATCH_BLOCKS * GHash::BLOCK_SIZE];
+    Byte keystream[BATCH_BLOCKS * GHash::BLOCK_SIZE];
+    uint32_t counter = endianness::bytesToUint32BE(j0 + NONCE_SIZE);
+    
+    for (size_t offset = 0; offset < length; ) {
+        size_t bytes = std::min(sizeof(keystream), length - offset);
+        size_t blocks = (bytes + GHash::BLOCK_SIZE - 1) / GHash::BLOCK_SIZE;
+        for (size_t i = 0; i < blocks; ++i) {
+            Byte* block = counters + i * GHash::BLOCK_SIZE;
+            std::memcpy(block, j0, NONCE_SIZE);
+            endianness::uint32ToBytesBE(++counter, block + NONCE_SIZE);
+        }
+        cipher_->encryptBlocks(counters, keystream, blocks);
+        
+        const Byte* in = input + offset;
+        Byte* out = output + offset;
+        if (!encrypting) {
+            ghash_->updatePadded(in, bytes);
+        }
+        for (size_t i = 0; i < bytes; ++i) {
+            out[i] = in[i] ^ keystream[i];
+        }
+        if (encrypting) {
+            ghash_->updatePadded(out, bytes);
+        }
+        offset += bytes;
+    }
+    
+    Byte lengths[GHash::BLOCK_SIZE];
+    endianness::uint64ToBytesBE(static_cast<uint64_t>(aad_.size()) * 8, lengths);
+    endianness::uint64ToBytesBE(static_cast<uint64_t>(length) * 8, lengths + 8);
+    ghash_->update(lengths, 1);
+    
+    Byte hash[GHash::BLOCK_SIZE];
+    ghash_->digest(hash);
+    cipher_->encryptBlock(j0, keystream);
+    
+    tag_.resize(TAG_SIZE);
+    for (size_t i = 0; i < TAG_SIZE; ++i) {
+        tag_[i] = keystream[i] ^ hash[i];
+    }
+}
+
+// Reusing a GCM nonce under one key reveals the GHASH key and allows forgeries.
+void GCMMode::sealWithFreshIV(const Byte* input, Byte* output, size_t length) {
+    if (ivUsed_) {
+        throw CryptoException("GCM IV already used; call setIV() or generateRandomIV() first");
+    }
+    process(true, input, output, length);
+    ivUsed_ = true;
+}
+
+ByteArray GCMMode::encrypt(const ByteArray& plaintext) {
+    ByteArray ciphertext(plaintext.size() + TAG_SIZE);
+    sealWithFreshIV(plaintext.data(), ciphertext.data(), plaintext.size());
+    std::copy(tag_.begin(), tag_.end(), ciphertext.begin() + plaintext.size());
+    return ciphertext;
+}
+
+ByteArray GCMMode::decrypt(const ByteArray& ciphertext) {
+    if (ciphertext.size() < TAG_SIZE) {
+        throw CryptoException("Ciphertext too short for GCM tag");
+    }
+    
+    size_t length = ciphertext.size() - TAG_SIZE;
+    ByteArray plaintext(length);
+    process(false, ciphertext.data(), plaintext.data(), length);
+    
+    if (!tagsEqual(tag_.data(), ciphertext.data() + length, TAG_SIZE)) {
+        std::fill(plaintext.begin(), plaintext.end(), 0);
+        throw CryptoException("GCM authentication failed");
+    }
+    return plaintext;
+}
+
+void GCMMode::encrypt(const Byte* input, Byte* output, size_t length) {
+    sealWithFreshIV(input, output, length);
+}
+
+void GCMMode::decrypt(const Byte* input, Byte* output, size_t length) {
+    if (expectedTag_.empty()) {
+        throw CryptoException("GCM tag must be set before decryption");
+    }
+    
+    process(false, input, output, length);
+    
+    if (!tagsEqual(tag_.data(), expectedTag_.data(), TAG_SIZE)) {
+        std::fill(output, output + length, 0);
+        throw CryptoException("GCM authentication failed");
+    }
+}
+
+void GCMMode::reset() {
+    tag_.clear();
+    expectedTag_.clear();
+}
+
+}
\ No newline at end of file
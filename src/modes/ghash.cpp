@@ -0,0 +1,216 @@
+#include "../../include/crypto/modes/ghash.hpp"
+#include "../../include/crypto/core/endianness.hpp"
+#include <cstring>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#include <immintrin.h>
+#define CRYPTO_GHASH_CLMUL 1
+#endif
+
+namespace crypto {
+
+namespace {
+
+const uint64_t REDUCTION[16] = {
+    0x0000, 0x1c20, 0x3840, 0x2460, 0x7080, 0x6ca0, 0x48c0, 0x54e0,
+    0xe100, 0xfd20, 0xd940, 0xc560, 0x9180, 0x8da0, 0xa9c0, 0xb5e0
+};
+
+#ifdef CRYPTO_GHASH_CLMUL
+
+__attribute__((target("pclmul,ssse3")))
+inline __m128i byteSwap(__m128i x) {
+    return _mm_shuffle_epi8(x, _mm_set_epi8(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15));
+}
+
+__attribute__((target("pclmul,ssse3")))
+inline void clmulWide(__m128i a, __m128i b, __m128i& low, __m128i& high) {
+    __m128i lo = _mm_clmulepi64_si128(a, b, 0x00);
+    __m128i mid = _mm_xor_si128(_mm_clmulepi64_si128(a, b, 0x10), _mm_clmulepi64_si128(a, b, 0x01));
+    __m128i hi = _mm_clmulepi64_si128(a, b, 0x11);
+    low = _mm_xor_si128(lo, _mm_slli_si128(mid, 8));
+    high = _mm_xor_si128(hi, _mm_srli_si128(mid, 8));
+}
+
+__attribute__((target("pclmul,ssse3")))
+inline __m128i clmulReduce(__m128i low, __m128i high) {
+    __m128i lowCarry = _mm_srli_epi32(low, 31);
+    __m128i highCarry = _mm_srli_epi32(high, 31);
+    low = _mm_slli_epi32(low, 1);
+    high = _mm_slli_epi32(high, 1);
+    __m128i crossCarry = _mm_srli_si128(lowCarry, 12);
+    highCarry = _mm_slli_si128(highCarry, 4);
+    lowCarry = _mm_slli_si128(lowCarry, 4);
+    low = _mm_or_si128(low, lowCarry);
+    high = _mm_or_si128(_mm_or_si128(high, highCarry), crossCarry);
+    
+    __m128i a = _mm_xor_si128(_mm_xor_si128(_mm_slli_epi32(low, 31), _mm_slli_epi32(low, 30)),
+                              _mm_slli_epi32(low, 25));
+    __m128i spill = _mm_srli_si128(a, 4);
+    low = _mm_xor_si128(low, _mm_slli_si128(a, 12));
+    
+    __m128i b = _mm_xor_si128(_mm_xor_si128(_mm_srli_epi32(low, 1), _mm_srli_epi32(low, 2)),
+                              _mm_srli_epi32(low, 7));
+    b = _mm_xor_si128(b, spill);
+    return _mm_xor_si128(high, _mm_xor_si128(low, b));
+}
+
+__attribute__((target("pclmul,ssse3")))
+inline __m128i clmulMultiply(__m128i a, __m128i b) {
+    __m128i low, high;
+    clmulWide(a, b, low, high);
+    return clmulReduce(low, high);
+}
+
+__attribute__((target("pclmul,ssse3")))
+void clmulPowers(const Byte* hashKey, Byte (*powers)[GHash::BLOCK_SIZE]) {
+    __m128i h = byteSwap(_mm_loadu_si128(reinterpret_cast<const __m128i*>(hashKey)));
+    __m128i power = h;
+    for (size_t i = 0; i < GHash::AGGREGATE_BLOCKS; ++i) {
+        _mm_store_si128(reinterpret_cast<__m128i*>(powers[i]), power);
+        power = clmulMultiply(power, h);
+    }
+}
+
+__attribute__((target("pclmul,ssse3")))
+void clmulUpdate(const Byte (*powers)[GHash::BLOCK_SIZE], Byte* state, const Byte* blocks, size_t count) {
+    const __m128i* h = reinterpret_cast<const __m128i*>(powers);
+    __m128i y = byteSwap(_mm_loadu_si128(reinterpret_cast<const __m128i*>(state)));
+    
+    for (; count >= GHash::AGGREGATE_BLOCKS; count -= GHash::AGGREGATE_BLOCKS) {
+        const __m128i* in = reinterpret_cast<const __m128i*>(blocks);
+        __m128i low, high, partLow, partHigh;
+        clmulWide(_mm_xor_si128(y, byteSwap(_mm_loadu_si128(in))), _mm_load_si128(h + 3), low, high);
+        for (size_t i = 1; i < GHash::AGGREGATE_BLOCKS; ++i) {
+            clmulWide(byteSwap(_mm_loadu_si128(in + i)),
+                      _mm_load_si128(h + GHash::AGGREGATE_BLOCKS - 1 - i), partLow, partHigh);
+            low = _mm_xor_si128(low, partLow);
+            high = _mm_xor_si128(high, partHigh);
+        }
+        y = clmulReduce(low, high);
+        blocks += GHash::AGGREGATE_BLOCKS * GHash::BLOCK_SIZE;
+    }
+    
+    for (; count > 0; --count) {
+        __m128i x = byteSwap(_mm_loadu_si128(reinterpret_cast<const __m128i*>(blocks)));
+        y = clmulMultiply(_mm_xor_si128(y, x), _mm_load_si128(h));
+        blocks += GHash::BLOCK_SIZE;
+    }
+    
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(state), byteSwap(y));
+}
+
+#endif
+
+}
+
+GHash::GHash(const Byte* hashKey, bool allowHardware)
+    : useClmul_(allowHardware && hardwareAvailable()) {
+    
+    uint64_t high = endianness::bytesToUint64BE(hashKey);
+    uint64_t low = endianness::bytesToUint64BE(hashKey + 8);
+    tableHigh_[0] = 0;
+    tableLow_[0] = 0;
+    tableHigh_[8] = high;
+    tableLow_[8] = low;
+    
+    for (size_t i = 4; i > 0; i >>= 1) {
+        uint64_t carry = (low & 1) ? 0xe100000000000000ULL : 0;
+        low = (high << 63) | (low >> 1);
+        high = (high >> 1) ^ carry;
+        tableHigh_[i] = high;
+        tableLow_[i] = low;
+    }
+    
+    for (size_t i = 2; i <= 8; i <<= 1) {
+        for (size_t j = 1; j < i; ++j) {
+            tableHigh_[i + j] = tableHigh_[i] ^ tableHigh_[j];
+            tableLow_[i + j] = tableLow_[i] ^ tableLow_[j];
+        }
+    }
+
+#ifdef CRYPTO_GHASH_CLMUL
+    if (useClmul_) {
+        clmulPowers(hashKey, powers_);
+    }
+#endif
+
+    reset();
+}
+
+bool GHash::hardwareAvailable() {
+#ifdef CRYPTO_GHASH_CLMUL
+    static const bool available = __builtin_cpu_supports("pclmul") && __builtin_cpu_supports("ssse3");
+    return available;
+#else
+    return false;
+#endif
+}
+
+void GHash::reset() {
+    std::memset(state_, 0, BLOCK_SIZE);
+}
+
+void GHash::multiplyPortable(Byte* x) const {
+    size_t nibble = x[15] & 0x0F;
+    uint64_t high = tableHigh_[nibble];
+    uint64_t low = tableLow_[nibble];
+    
+    for (size_t i = BLOCK_SIZE; i > 0; --i) {
+        Byte byte = x[i - 1];
+        
+        if (i != BLOCK_SIZE) {
+            size_t rem = low & 0x0F;
+            low = (high << 60) | (low >> 4);
+            high = (high >> 4) ^ (REDUCTION[rem] << 48);
+            high ^= tableHigh_[byte & 0x0F];
+            low ^= tableLow_[byte & 0x0F];
+        }
+        
+        size_t rem = low & 0x0F;
+        low = (high << 60) | (low >> 4);
+        high = (high >> 4) ^ (REDUCTION[rem] << 48);
+        high ^= tableHigh_[byte >> 4];
+        low ^= tableLow_[byte >> 4];
+    }
+    
+    endianness::uint64ToBytesBE(high, x);
+    endianness::uint64ToBytesBE(low, x + 8);
+}
+
+void GHash::updatePortable(const Byte* blocks, size_t count) {
+    for (size_t i = 0; i < count; ++i) {
+        for (size_t j = 0; j < BLOCK_SIZE; ++j) {
+            state_[j] ^= blocks[j];
+        }
+        multiplyPortable(state_);
+        blocks += BLOCK_SIZE;
+    }
+}
+
+void GHash::update(const Byte* blocks, size_t count) {
+#ifdef CRYPTO_GHASH_CLMUL
+    if (useClmul_) {
+        clmulUpdate(powers_, state_, blocks, count);
+        return;
+    }
+#endif
+    updatePortable(blocks, count);
+}
+
+void GHash::updatePadded(const Byte* data, size_t length) {
+    update(data, length / BLOCK_SIZE);
+    
+    size_t tail = length % BLOCK_SIZE;
+    if (tail != 0) {
+        Byte block[BLOCK_SIZE] = {};
+        std::memcpy(block, data + length - tail, tail);
+        update(block, 1);
+    }
+}
+
+void GHash::digest(Byte* output) const {
+    std::memcpy(output, state_, BLOCK_SIZE);
+}
+
+}
\ No newline at end of file
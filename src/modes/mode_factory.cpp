@@ -6,6 +6,7 @@
 #include "../../include/crypto/modes/ofb.hpp"
 #include "../../include/crypto/modes/ctr.hpp"
 #include "../../include/crypto/modes/random_delta.hpp"
+#include "../../include/crypto/modes/gcm.hpp"
 #include <memory>
 
 namespace crypto {
@@ -40,6 +41,11 @@ std::unique_ptr<IBlockCipherMode> IBlockCipherMode::create(
         case CipherMode::RANDOM_DELTA:
             modeObj = std::make_unique<RandomDeltaMode>(cipher, std::move(padding));
             break;
+        case CipherMode::GCM:
+            modeObj = std::make_unique<GCMMode>(cipher, std::move(padding));
+            break;
+        case CipherMode::XTS:
+            throw CryptoException("XTS needs separate data and tweak ciphers; construct XTSMode directly");
         default:
             throw CryptoException("Unsupported cipher mode");
     }
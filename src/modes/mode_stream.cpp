@@ -0,0 +1,134 @@
+#include "../../include/crypto/modes/mode.hpp"
+#include "../../include/crypto/core/exceptions.hpp"
+#include <algorithm>
+
+namespace crypto {
+
+IBlockCipherMode::StreamLayout IBlockCipherMode::streamLayout() const {
+    throw CryptoException("Streaming is not supported by " + name());
+}
+
+void IBlockCipherMode::streamStart(bool) {
+    reset();
+}
+
+void IBlockCipherMode::streamProcess(bool encrypting, const Byte* input, Byte* output, size_t length) {
+    if (encrypting) {
+        encrypt(input, output, length);
+    } else {
+        decrypt(input, output, length);
+    }
+}
+
+size_t IBlockCipherMode::encryptInPlace(Byte* buffer, size_t length, size_t capacity) {
+    StreamLayout layout = streamLayout();
+    if (layout.padding) {
+        length = layout.padding->padInPlace(buffer, length, capacity, layout.blockSize);
+    } else if (length > capacity) {
+        throw CryptoException("Length exceeds buffer capacity");
+    }
+    
+    encrypt(buffer, buffer, length);
+    return length;
+}
+
+size_t IBlockCipherMode::decryptInPlace(Byte* buffer, size_t length) {
+    StreamLayout layout = streamLayout();
+    decrypt(buffer, buffer, length);
+    
+    if (layout.padding) {
+        return layout.padding->unpaddedLength(buffer, length);
+    }
+    return length;
+}
+
+void IBlockCipherMode::startEncryption() {
+    startStream(true);
+}
+
+void IBlockCipherMode::startDecryption() {
+    startStream(false);
+}
+
+void IBlockCipherMode::startStream(bool encrypting) {
+    StreamLayout layout = streamLayout();
+    streamStart(encrypting);
+    streamPending_.clear();
+    streamPending_.reserve(layout.blockSize);
+    streamEncrypting_ = encrypting;
+    streamActive_ = true;
+}
+
+size_t IBlockCipherMode::update(const Byte* input, size_t length, Byte* output) {
+    if (!streamActive_) {
+        throw CryptoException("Stream not started");
+    }
+    
+    StreamLayout layout = streamLayout();
+    size_t unit = layout.padding ? layout.blockSize : layout.unit;
+    size_t total = streamPending_.size() + length;
+    size_t ready = total / unit * unit;
+    if (!streamEncrypting_ && layout.padding && ready == total && ready > 0) {
+        ready -= unit;
+    }
+    
+    if (ready == 0) {
+        streamPending_.insert(streamPending_.end(), input, input + length);
+        return 0;
+    }
+    
+    size_t written = 0;
+    if (!streamPending_.empty()) {
+        size_t fill = unit - streamPending_.size();
+        streamPending_.insert(streamPending_.end(), input, input + fill);
+        streamProcess(streamEncrypting_, streamPending_.data(), output, unit);
+        streamPending_.clear();
+        input += fill;
+        length -= fill;
+        written = unit;
+    }
+    
+    size_t direct = ready - written;
+    streamProcess(streamEncrypting_, input, output + written, direct);
+    streamPending_.assign(input + direct, input + length);
+    return ready;
+}
+
+size_t IBlockCipherMode::finalize(Byte* output) {
+    if (!streamActive_) {
+        throw CryptoException("Stream not started");
+    }
+    streamActive_ = false;
+    
+    StreamLayout layout = streamLayout();
+    if (!layout.padding) {
+        size_t length = streamPending_.size();
+        if (length > 0) {
+            streamProcess(streamEncrypting_, streamPending_.data(), output, length);
+        }
+        streamPending_.clear();
+        return length;
+    }
+    
+    if (streamEncrypting_) {
+        size_t length = streamPending_.size();
+        std::copy(streamPending_.begin(), streamPending_.end(), output);
+        streamPending_.clear();
+        length = layout.padding->padInPlace(output, length, MAX_BLOCK_SIZE, layout.blockSize);
+        streamProcess(true, output, output, length);
+        return length;
+    }
+    
+    if (!streamPending_.empty() && streamPending_.size() != layout.blockSize) {
+        throw CryptoException("Ciphertext size must be multiple of block size");
+    }
+    size_t length = streamPending_.size();
+    if (length > 0) {
+        streamProcess(false, streamPending_.data(), output, length);
+    }
+    streamPending_.clear();
+    
+    return layout.padding->unpaddedLength(output, length);
+}
+
+}
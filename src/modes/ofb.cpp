@@ -18,6 +18,9 @@ OFBMode::OFBMode(std::shared_ptr<IBlockCipher> cipher,
     }
     
     blockSize_ = cipher_->blockSize();
+    if (blockSize_ > MAX_BLOCK_SIZE) {
+        throw CryptoException("Cipher block size exceeds MAX_BLOCK_SIZE");
+    }
     generateRandomIV();
     keystream_.resize(blockSize_);
     generateKeystream();
@@ -29,6 +32,9 @@ void OFBMode::setCipher(std::shared_ptr<IBlockCipher> cipher) {
     }
     cipher_ = std::move(cipher);
     blockSize_ = cipher_->blockSize();
+    if (blockSize_ > MAX_BLOCK_SIZE) {
+        throw CryptoException("Cipher block size exceeds MAX_BLOCK_SIZE");
+    }
     generateRandomIV();
     keystream_.resize(blockSize_);
     keystreamPos_ = 0;
@@ -58,45 +64,33 @@ void OFBMode::generateRandomIV() {
 }
 
 ByteArray OFBMode::encrypt(const ByteArray& plaintext) {
-    ByteArray data = plaintext;
-    
-    if (usePadding_) {
-        data = padding_->pad(data, blockSize_);
-    }
-    
-    ByteArray ciphertext(data.size());
-    encrypt(data.data(), ciphertext.data(), data.size());
+    ByteArray ciphertext(plaintext.size() + (usePadding_ ? blockSize_ : 0));
+    std::copy(plaintext.begin(), plaintext.end(), ciphertext.begin());
+    ciphertext.resize(encryptInPlace(ciphertext.data(), plaintext.size(), ciphertext.size()));
     return ciphertext;
 }
 
 ByteArray OFBMode::decrypt(const ByteArray& ciphertext) {
-    ByteArray plaintext(ciphertext.size());
-    decrypt(ciphertext.data(), plaintext.data(), ciphertext.size());
-    
-    if (usePadding_) {
-        plaintext = padding_->unpad(plaintext);
-    }
-    
+    ByteArray plaintext = ciphertext;
+    plaintext.resize(decryptInPlace(plaintext.data(), plaintext.size()));
     return plaintext;
 }
 
 void OFBMode::generateKeystream() {
-    ByteArray input = iv_;
+    Byte block[MAX_BLOCK_SIZE];
+    std::memcpy(block, iv_.data(), blockSize_);
     
     while (keystream_.size() < blockSize_ * 4) {
-        ByteArray output(blockSize_);
-        cipher_->encryptBlock(input.data(), output.data());
-        keystream_.insert(keystream_.end(), output.begin(), output.end());
-        input = output;
+        cipher_->encryptBlock(block, block);
+        keystream_.insert(keystream_.end(), block, block + blockSize_);
     }
 }
 
 void OFBMode::generateMoreKeystream() {
     if (keystreamPos_ + blockSize_ > keystream_.size()) {
-        ByteArray input(keystream_.end() - blockSize_, keystream_.end());
-        ByteArray output(blockSize_);
-        cipher_->encryptBlock(input.data(), output.data());
-        keystream_.insert(keystream_.end(), output.begin(), output.end());
+        Byte block[MAX_BLOCK_SIZE];
+        cipher_->encryptBlock(&keystream_[keystream_.size() - blockSize_], block);
+        keystream_.insert(keystream_.end(), block, block + blockSize_);
     }
 }
 
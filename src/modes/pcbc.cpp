@@ -17,6 +17,9 @@ PCBCMode::PCBCMode(std::shared_ptr<IBlockCipher> cipher,
     }
     
     blockSize_ = cipher_->blockSize();
+    if (blockSize_ > MAX_BLOCK_SIZE) {
+        throw CryptoException("Cipher block size exceeds MAX_BLOCK_SIZE");
+    }
     generateRandomIV();
 }
 
@@ -26,6 +29,9 @@ void PCBCMode::setCipher(std::shared_ptr<IBlockCipher> cipher) {
     }
     cipher_ = std::move(cipher);
     blockSize_ = cipher_->blockSize();
+    if (blockSize_ > MAX_BLOCK_SIZE) {
+        throw CryptoException("Cipher block size exceeds MAX_BLOCK_SIZE");
+    }
     generateRandomIV();
 }
 
@@ -50,16 +56,13 @@ void PCBCMode::generateRandomIV() {
 }
 
 ByteArray PCBCMode::encrypt(const ByteArray& plaintext) {
-    ByteArray data = plaintext;
-    
-    if (usePadding_) {
-        data = padding_->pad(data, blockSize_);
-    } else if (data.size() % blockSize_ != 0) {
+    if (!usePadding_ && plaintext.size() % blockSize_ != 0) {
         throw CryptoException("Data size must be multiple of block size when padding is disabled");
     }
     
-    ByteArray ciphertext(data.size());
-    encrypt(data.data(), ciphertext.data(), data.size());
+    ByteArray ciphertext(plaintext.size() + (usePadding_ ? blockSize_ : 0));
+    std::copy(plaintext.begin(), plaintext.end(), ciphertext.begin());
+    ciphertext.resize(encryptInPlace(ciphertext.data(), plaintext.size(), ciphertext.size()));
     return ciphertext;
 }
 
@@ -68,64 +71,87 @@ ByteArray PCBCMode::decrypt(const ByteArray& ciphertext) {
         throw CryptoException("Ciphertext size must be multiple of block size");
     }
     
-    ByteArray plaintext(ciphertext.size());
-    decrypt(ciphertext.data(), plaintext.data(), ciphertext.size());
-    
-    if (usePadding_) {
-        plaintext = padding_->unpad(plaintext);
-    }
-    
+    ByteArray plaintext = ciphertext;
+    plaintext.resize(decryptInPlace(plaintext.data(), plaintext.size()));
     return plaintext;
 }
 
-void PCBCMode::encrypt(const Byte* input, Byte* output, size_t length) {
-    if (length % blockSize_ != 0) {
-        throw CryptoException("Input length must be multiple of block size");
-    }
+void PCBCMode::encryptChained(const Byte* input, Byte* output, size_t blocks,
+                              Byte* previousPlain, Byte* previousCipher) {
+    Byte xored[MAX_BLOCK_SIZE];
     
-    size_t numBlocks = length / blockSize_;
-    ByteArray previousPlain = iv_;
-    ByteArray previousCipher(blockSize_);
-    
-    for (size_t i = 0; i < numBlocks; ++i) {
+    for (size_t i = 0; i < blocks; ++i) {
         const Byte* blockInput = input + i * blockSize_;
         Byte* blockOutput = output + i * blockSize_;
-        ByteArray xored(blockSize_);
         
-        utils::xorBlocks(blockInput, previousPlain.data(), xored.data(), blockSize_);
-        utils::xorBlocksInPlace(xored.data(), previousCipher.data(), blockSize_);
+        utils::xorBlocks(blockInput, previousPlain, xored, blockSize_);
+        utils::xorBlocksInPlace(xored, previousCipher, blockSize_);
+        std::memcpy(previousPlain, blockInput, blockSize_);
         
-        cipher_->encryptBlock(xored.data(), blockOutput);
+        cipher_->encryptBlock(xored, blockOutput);
         
-        previousPlain.assign(blockInput, blockInput + blockSize_);
-        previousCipher.assign(blockOutput, blockOutput + blockSize_);
+        std::memcpy(previousCipher, blockOutput, blockSize_);
     }
 }
 
-void PCBCMode::decrypt(const Byte* input, Byte* output, size_t length) {
-    if (length % blockSize_ != 0) {
-        throw CryptoException("Input length must be multiple of block size");
-    }
+void PCBCMode::decryptChained(const Byte* input, Byte* output, size_t blocks,
+                              Byte* previousPlain, Byte* previousCipher) {
+    Byte decrypted[MAX_BLOCK_SIZE];
     
-    size_t numBlocks = length / blockSize_;
-    ByteArray previousPlain = iv_;
-    ByteArray previousCipher(blockSize_);
-    
-    for (size_t i = 0; i < numBlocks; ++i) {
+    for (size_t i = 0; i < blocks; ++i) {
         const Byte* blockInput = input + i * blockSize_;
         Byte* blockOutput = output + i * blockSize_;
-        ByteArray decrypted(blockSize_);
         
-        cipher_->decryptBlock(blockInput, decrypted.data());
+        cipher_->decryptBlock(blockInput, decrypted);
         
-        utils::xorBlocks(decrypted.data(), previousPlain.data(), blockOutput, blockSize_);
-        utils::xorBlocksInPlace(blockOutput, previousCipher.data(), blockSize_);
+        utils::xorBlocksInPlace(decrypted, previousPlain, blockSize_);
+        utils::xorBlocksInPlace(decrypted, previousCipher, blockSize_);
         
-        previousPlain.assign(blockOutput, blockOutput + blockSize_);
-        previousCipher.assign(blockInput, blockInput + blockSize_);
+        std::memcpy(previousCipher, blockInput, blockSize_);
+        std::memcpy(previousPlain, decrypted, blockSize_);
+        std::memcpy(blockOutput, decrypted, blockSize_);
     }
 }
 
+void PCBCMode::encrypt(const Byte* input, Byte* output, size_t length) {
+    if (length % blockSize_ != 0) {
+        throw CryptoException("Input length must be multiple of block size");
+    }
+    
+    Byte previousPlain[MAX_BLOCK_SIZE];
+    Byte previousCipher[MAX_BLOCK_SIZE] = {};
+    std::memcpy(previousPlain, iv_.data(), blockSize_);
+    encryptChained(input, output, length / blockSize_, previousPlain, previousCipher);
+}
+
+void PCBCMode::decrypt(const Byte* input, Byte* output, size_t length) {
+    if (length % blockSize_ != 0) {
+        throw CryptoException("Input length must be multiple of block size");
+    }
+    
+    Byte previousPlain[MAX_BLOCK_SIZE];
+    Byte previousCipher[MAX_BLOCK_SIZE] = {};
+    std::memcpy(previousPlain, iv_.data(), blockSize_);
+    decryptChained(input, output, length / blockSize_, previousPlain, previousCipher);
+}
+
 void PCBCMode::reset() {}
 
+void PCBCMode::streamStart(bool) {
+    streamPlain_ = iv_;
+    streamCipher_.assign(blockSize_, 0);
+}
+
+void PCBCMode::streamProcess(bool encrypting, const Byte* input, Byte* output, size_t length) {
+    if (length % blockSize_ != 0) {
+        throw CryptoException("Input length must be multiple of block size");
+    }
+    
+    if (encrypting) {
+        encryptChained(input, output, length / blockSize_, streamPlain_.data(), streamCipher_.data());
+    } else {
+        decryptChained(input, output, length / blockSize_, streamPlain_.data(), streamCipher_.data());
+    }
+}
+
 }
\ No newline at end of file
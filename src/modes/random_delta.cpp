@@ -1,7 +1,9 @@
 #include "../../include/crypto/modes/random_delta.hpp"
+#include "../../include/crypto/modes/block_ranges.hpp"
 #include "../../include/crypto/core/utils.hpp"
 #include "../../include/crypto/math/random.hpp"
 #include <stdexcept>
+#include <algorithm>
 #include <cstring>
 
 namespace crypto {
@@ -17,8 +19,10 @@ RandomDeltaMode::RandomDeltaMode(std::shared_ptr<IBlockCipher> cipher,
     }
     
     blockSize_ = cipher_->blockSize();
+    if (blockSize_ > MAX_BLOCK_SIZE) {
+        throw CryptoException("Cipher block size exceeds MAX_BLOCK_SIZE");
+    }
     generateRandomIV();
-    delta_.resize(blockSize_);
 }
 
 void RandomDeltaMode::setCipher(std::shared_ptr<IBlockCipher> cipher) {
@@ -27,8 +31,10 @@ void RandomDeltaMode::setCipher(std::shared_ptr<IBlockCipher> cipher) {
     }
     cipher_ = std::move(cipher);
     blockSize_ = cipher_->blockSize();
+    if (blockSize_ > MAX_BLOCK_SIZE) {
+        throw CryptoException("Cipher block size exceeds MAX_BLOCK_SIZE");
+    }
     generateRandomIV();
-    delta_.resize(blockSize_);
 }
 
 void RandomDeltaMode::setPadding(std::unique_ptr<IPadding> padding) {
@@ -36,11 +42,16 @@ void RandomDeltaMode::setPadding(std::unique_ptr<IPadding> padding) {
     usePadding_ = (padding_ != nullptr);
 }
 
+void RandomDeltaMode::setThreadPool(std::shared_ptr<ThreadPool> pool) {
+    pool_ = std::move(pool);
+}
+
 void RandomDeltaMode::setIV(const ByteArray& iv) {
     if (iv.size() != blockSize_) {
         throw CryptoException("IV size must equal block size");
     }
     iv_ = iv;
+    generateDelta();
 }
 
 ByteArray RandomDeltaMode::getIV() const {
@@ -49,28 +60,28 @@ ByteArray RandomDeltaMode::getIV() const {
 
 void RandomDeltaMode::generateRandomIV() {
     iv_ = math::randomBytes(blockSize_);
+    generateDelta();
 }
 
-void RandomDeltaMode::generateDelta(size_t blockIndex) {
+// The delta keeps only the LCG's low byte, which depends only on the seed's low byte;
+// the block index enters the seed as a multiple of 256, so one delta serves every block.
+void RandomDeltaMode::generateDelta() {
+    delta_.resize(blockSize_);
     for (size_t i = 0; i < blockSize_; ++i) {
-        uint32_t seed = static_cast<uint32_t>(iv_[i % iv_.size()]) + 
-                       static_cast<uint32_t>(blockIndex * 256 + i);
+        uint32_t seed = static_cast<uint32_t>(iv_[i]) + static_cast<uint32_t>(i);
         seed = (seed * 1103515245 + 12345) & 0x7fffffff;
         delta_[i] = static_cast<Byte>(seed & 0xFF);
     }
 }
 
 ByteArray RandomDeltaMode::encrypt(const ByteArray& plaintext) {
-    ByteArray data = plaintext;
-    
-    if (usePadding_) {
-        data = padding_->pad(data, blockSize_);
-    } else if (data.size() % blockSize_ != 0) {
+    if (!usePadding_ && plaintext.size() % blockSize_ != 0) {
         throw CryptoException("Data size must be multiple of block size when padding is disabled");
     }
     
-    ByteArray ciphertext(data.size());
-    encrypt(data.data(), ciphertext.data(), data.size());
+    ByteArray ciphertext(plaintext.size() + (usePadding_ ? blockSize_ : 0));
+    std::copy(plaintext.begin(), plaintext.end(), ciphertext.begin());
+    ciphertext.resize(encryptInPlace(ciphertext.data(), plaintext.size(), ciphertext.size()));
     return ciphertext;
 }
 
@@ -79,75 +90,148 @@ ByteArray RandomDeltaMode::decrypt(const ByteArray& ciphertext) {
         throw CryptoException("Ciphertext size must be multiple of block size");
     }
     
-    ByteArray plaintext(ciphertext.size());
-    decrypt(ciphertext.data(), plaintext.data(), ciphertext.size());
-    
-    if (usePadding_) {
-        plaintext = padding_->unpad(plaintext);
-    }
-    
+    ByteArray plaintext = ciphertext;
+    plaintext.resize(decryptInPlace(plaintext.data(), plaintext.size()));
     return plaintext;
 }
 
-void RandomDeltaMode::encrypt(const Byte* input, Byte* output, size_t length) {
-    if (length % blockSize_ != 0) {
-        throw CryptoException("Input length must be multiple of block size");
-    }
+void RandomDeltaMode::encryptChained(const Byte* input, Byte* output, size_t blocks,
+                                     Byte* currentIV) const {
+    Byte xored[MAX_BLOCK_SIZE];
     
-    size_t numBlocks = length / blockSize_;
-    ByteArray currentIV = iv_;
-    
-    for (size_t i = 0; i < numBlocks; ++i) {
+    for (size_t i = 0; i < blocks; ++i) {
         const Byte* blockInput = input + i * blockSize_;
         Byte* blockOutput = output + i * blockSize_;
         
-        generateDelta(i);
-        
-        ByteArray modifiedIV(blockSize_);
-        utils::xorBlocks(currentIV.data(), delta_.data(), modifiedIV.data(), blockSize_);
+        utils::xorBlocks(currentIV, delta_.data(), xored, blockSize_);
+        utils::xorBlocksInPlace(xored, blockInput, blockSize_);
         
-        ByteArray xored(blockSize_);
-        utils::xorBlocks(blockInput, modifiedIV.data(), xored.data(), blockSize_);
+        cipher_->encryptBlock(xored, currentIV);
         
-        cipher_->encryptBlock(xored.data(), blockOutput);
+        utils::xorBlocks(currentIV, delta_.data(), blockOutput, blockSize_);
+    }
+}
+
+void RandomDeltaMode::decryptChained(const Byte* input, Byte* output, size_t blocks,
+                                     Byte* currentIV) const {
+    Byte stripped[BATCH_BLOCKS * MAX_BLOCK_SIZE];
+    Byte decrypted[BATCH_BLOCKS * MAX_BLOCK_SIZE];
+    
+    for (size_t done = 0; done < blocks; ) {
+        size_t batch = std::min(BATCH_BLOCKS, blocks - done);
+        const Byte* batchInput = input + done * blockSize_;
+        Byte* batchOutput = output + done * blockSize_;
         
-        utils::xorBlocksInPlace(blockOutput, delta_.data(), blockSize_);
+        for (size_t i = 0; i < batch; ++i) {
+            utils::xorBlocks(batchInput + i * blockSize_, delta_.data(), stripped + i * blockSize_, blockSize_);
+        }
+        cipher_->decryptBlocks(stripped, decrypted, batch);
         
-        ByteArray ciphertextWithoutDelta(blockOutput, blockOutput + blockSize_);
-        utils::xorBlocksInPlace(ciphertextWithoutDelta.data(), delta_.data(), blockSize_);
-        currentIV = ciphertextWithoutDelta;
+        for (size_t i = 0; i < batch; ++i) {
+            const Byte* previous = i == 0 ? currentIV : stripped + (i - 1) * blockSize_;
+            Byte* block = decrypted + i * blockSize_;
+            utils::xorBlocksInPlace(block, previous, blockSize_);
+            utils::xorBlocksInPlace(block, delta_.data(), blockSize_);
+        }
+        std::memcpy(currentIV, stripped + (batch - 1) * blockSize_, blockSize_);
+        std::memcpy(batchOutput, decrypted, batch * blockSize_);
+        done += batch;
     }
 }
 
+void RandomDeltaMode::encrypt(const Byte* input, Byte* output, size_t length) {
+    if (length % blockSize_ != 0) {
+        throw CryptoException("Input length must be multiple of block size");
+    }
+    
+    Byte currentIV[MAX_BLOCK_SIZE];
+    std::memcpy(currentIV, iv_.data(), blockSize_);
+    encryptChained(input, output, length / blockSize_, currentIV);
+}
+
+// previous is the ciphertext block before input; block 0 uses iv ^ delta, so every
+// range recovers its chaining value by stripping the delta.
+void RandomDeltaMode::decryptWindow(const Byte* input, Byte* output, size_t blocks,
+                                    const Byte* previous) const {
+    runChainedRanges(pool_.get(), input, previous, blockSize_, blocks,
+                     [&](size_t first, size_t count, const Byte* boundary) {
+        Byte chain[MAX_BLOCK_SIZE];
+        utils::xorBlocks(boundary, delta_.data(), chain, blockSize_);
+        size_t start = first * blockSize_;
+        decryptChained(input + start, output + start, count, chain);
+    });
+}
+
 void RandomDeltaMode::decrypt(const Byte* input, Byte* output, size_t length) {
     if (length % blockSize_ != 0) {
         throw CryptoException("Input length must be multiple of block size");
     }
     
-    size_t numBlocks = length / blockSize_;
-    ByteArray currentIV = iv_;
+    Byte previous[MAX_BLOCK_SIZE];
+    utils::xorBlocks(iv_.data(), delta_.data(), previous, blockSize_);
+    decryptWindow(input, output, length / blockSize_, previous);
+}
+
+ByteArray RandomDeltaMode::decryptRange(const ByteArray& ciphertext, uint64_t blockOffset,
+                                        size_t blocks) const {
+    uint64_t available = ciphertext.size() / blockSize_;
+    if (blockOffset > available || blocks > available - blockOffset) {
+        throw CryptoException("Ciphertext range exceeds input");
+    }
     
-    for (size_t i = 0; i < numBlocks; ++i) {
-        const Byte* blockInput = input + i * blockSize_;
-        Byte* blockOutput = output + i * blockSize_;
-        
-        generateDelta(i);
-        
-        ByteArray ciphertextWithoutDelta(blockSize_);
-        utils::xorBlocks(blockInput, delta_.data(), ciphertextWithoutDelta.data(), blockSize_);
-        
-        ByteArray decrypted(blockSize_);
-        cipher_->decryptBlock(ciphertextWithoutDelta.data(), decrypted.data());
-        
-        ByteArray modifiedIV(blockSize_);
-        utils::xorBlocks(currentIV.data(), delta_.data(), modifiedIV.data(), blockSize_);
-        
-        utils::xorBlocks(decrypted.data(), modifiedIV.data(), blockOutput, blockSize_);
-        
-        currentIV = ciphertextWithoutDelta;
+    size_t start = static_cast<size_t>(blockOffset) * blockSize_;
+    Byte previous[MAX_BLOCK_SIZE];
+    if (blockOffset == 0) {
+        utils::xorBlocks(iv_.data(), delta_.data(), previous, blockSize_);
+    } else {
+        std::memcpy(previous, ciphertext.data() + start - blockSize_, blockSize_);
     }
+    
+    ByteArray plaintext(blocks * blockSize_);
+    decryptWindow(ciphertext.data() + start, plaintext.data(), blocks, previous);
+    return plaintext;
+}
+
+ByteArray RandomDeltaMode::decryptRange(std::istream& ciphertext, uint64_t blockOffset,
+                                        size_t blocks) const {
+    // A previous out-of-range read leaves failbit/eofbit set, which would make seekg fail.
+    ciphertext.clear();
+    Byte previous[MAX_BLOCK_SIZE];
+    if (blockOffset == 0) {
+        ciphertext.seekg(0);
+        utils::xorBlocks(iv_.data(), delta_.data(), previous, blockSize_);
+    } else {
+        ciphertext.seekg(static_cast<std::streamoff>((blockOffset - 1) * blockSize_));
+        ciphertext.read(reinterpret_cast<char*>(previous), blockSize_);
+    }
+    
+    ByteArray plaintext(blocks * blockSize_);
+    ciphertext.read(reinterpret_cast<char*>(plaintext.data()), plaintext.size());
+    if (!ciphertext) {
+        throw CryptoException("Ciphertext range exceeds input");
+    }
+    
+    decryptWindow(plaintext.data(), plaintext.data(), blocks, previous);
+    return plaintext;
 }
 
 void RandomDeltaMode::reset() {}
 
+void RandomDeltaMode::streamStart(bool) {
+    chain_ = iv_;
+}
+
+void RandomDeltaMode::streamProcess(bool encrypting, const Byte* input, Byte* output, size_t length) {
+    if (length % blockSize_ != 0) {
+        throw CryptoException("Input length must be multiple of block size");
+    }
+    
+    size_t blocks = length / blockSize_;
+    if (encrypting) {
+        encryptChained(input, output, blocks, chain_.data());
+    } else {
+        decryptChained(input, output, blocks, chain_.data());
+    }
+}
+
 }
\ No newline at end of file
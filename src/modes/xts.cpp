@@ -0,0 +1,231 @@
+#include "../../include/crypto/modes/xts.hpp"
+#include "../../include/crypto/modes/block_ranges.hpp"
+#include "../../include/crypto/core/endianness.hpp"
+#include <algorithm>
+#include <cstring>
+
+namespace crypto {
+
+namespace {
+
+constexpr size_t XTS_BLOCK = 16;
+
+void multiplyAlpha(Byte* tweak) {
+    Byte carry = 0;
+    for (size_t i = 0; i < XTS_BLOCK; ++i) {
+        Byte next = tweak[i] >> 7;
+        tweak[i] = static_cast<Byte>((tweak[i] << 1) | carry);
+        carry = next;
+    }
+    if (carry) {
+        tweak[0] ^= 0x87;
+    }
+}
+
+void xorBlocks(Byte* target, const Byte* mask, size_t length) {
+    for (size_t i = 0; i < length; ++i) {
+        target[i] ^= mask[i];
+    }
+}
+
+}
+
+XTSMode::XTSMode(std::shared_ptr<IBlockCipher> cipher,
+                 std::shared_ptr<IBlockCipher> tweakCipher,
+                 size_t sectorSize)
+    : cipher_(std::move(cipher))
+    , tweakCipher_(std::move(tweakCipher))
+    , sectorSize_(sectorSize)
+    , sector_(0) {
+    
+    checkCipher(cipher_.get());
+    checkCipher(tweakCipher_.get());
+    
+    if (sectorSize_ < XTS_BLOCK) {
+        throw CryptoException("XTS sector size must be at least 16 bytes");
+    }
+}
+
+void XTSMode::checkCipher(const IBlockCipher* cipher) {
+    if (!cipher) {
+        throw CryptoException("Cipher cannot be null");
+    }
+    if (cipher->blockSize() != XTS_BLOCK) {
+        throw CryptoException("XTS requires a 128-bit block cipher");
+    }
+}
+
+void XTSMode::setCipher(std::shared_ptr<IBlockCipher> cipher) {
+    checkCipher(cipher.get());
+    cipher_ = std::move(cipher);
+}
+
+void XTSMode::setTweakCipher(std::shared_ptr<IBlockCipher> cipher) {
+    checkCipher(cipher.get());
+    tweakCipher_ = std::move(cipher);
+}
+
+void XTSMode::setPadding(std::unique_ptr<IPadding>) {
+}
+
+void XTSMode::setThreadPool(std::shared_ptr<ThreadPool> pool) {
+    pool_ = std::move(pool);
+}
+
+void XTSMode::setIV(const ByteArray& iv) {
+    if (iv.size() != XTS_BLOCK) {
+        throw CryptoException("XTS IV must be a 16-byte sector number");
+    }
+    if (std::any_of(iv.begin() + 8, iv.end(), [](Byte b) { return b != 0; })) {
+        throw CryptoException("XTS sector number must fit in 64 bits");
+    }
+    sector_ = endianness::bytesToUint64LE(iv.data());
+}
+
+ByteArray XTSMode::getIV() const {
+    ByteArray iv(XTS_BLOCK, 0);
+    endianness::uint64ToBytesLE(sector_, iv.data());
+    return iv;
+}
+
+void XTSMode::generateRandomIV() {
+    sector_ = 0;
+}
+
+void XTSMode::processSector(bool encrypting, uint64_t sector, const Byte* input, Byte* output,
+                            size_t length) const {
+    if (length < XTS_BLOCK) {
+        throw CryptoException("XTS data unit must be at least 16 bytes");
+    }
+    
+    Byte tweak[XTS_BLOCK] = {};
+    endianness::uint64ToBytesLE(sector, tweak);
+    tweakCipher_->encryptBlock(tweak, tweak);
+    
+    size_t blocks = length / XTS_BLOCK;
+    size_t tail = length % XTS_BLOCK;
+    size_t bulk = tail ? blocks - 1 : blocks;
+    
+    Byte masks[BATCH_BLOCKS * XTS_BLOCK];
+    Byte work[BATCH_BLOCKS * XTS_BLOCK];
+    for (size_t done = 0; done < bulk; ) {
+        size_t batch = std::min(BATCH_BLOCKS, bulk - done);
+        size_t bytes = batch * XTS_BLOCK;
+        for (size_t i = 0; i < batch; ++i) {
+            std::memcpy(masks + i * XTS_BLOCK, tweak, XTS_BLOCK);
+            multiplyAlpha(tweak);
+        }
+        
+        std::memcpy(work, input + done * XTS_BLOCK, bytes);
+        xorBlocks(work, masks, bytes);
+        if (encrypting) {
+            cipher_->encryptBlocks(work, work, batch);
+        } else {
+            cipher_->decryptBlocks(work, work, batch);
+        }
+        xorBlocks(work, masks, bytes);
+        std::memcpy(output + done * XTS_BLOCK, work, bytes);
+        done += batch;
+    }
+    
+    if (tail == 0) {
+        return;
+    }
+    
+    Byte lastTweak[XTS_BLOCK];
+    std::memcpy(lastTweak, tweak, XTS_BLOCK);
+    multiplyAlpha(lastTweak);
+    
+    const Byte* fullIn = input + bulk * XTS_BLOCK;
+    const Byte* tailIn = fullIn + XTS_BLOCK;
+    Byte* fullOut = output + bulk * XTS_BLOCK;
+    Byte* tailOut = fullOut + XTS_BLOCK;
+    
+    // Ciphertext stealing: the short final block borrows the tail of the block before it.
+    const Byte* firstTweak = encrypting ? tweak : lastTweak;
+    const Byte* secondTweak = encrypting ? lastTweak : tweak;
+    Byte block[XTS_BLOCK];
+    Byte stolen[XTS_BLOCK];
+    std::memcpy(block, fullIn, XTS_BLOCK);
+    std::memcpy(stolen, tailIn, tail);
+    
+    xorBlocks(block, firstTweak, XTS_BLOCK);
+    if (encrypting) {
+        cipher_->encryptBlock(block, block);
+    } else {
+        cipher_->decryptBlock(block, block);
+    }
+    xorBlocks(block, firstTweak, XTS_BLOCK);
+    
+    std::memcpy(stolen + tail, block + tail, XTS_BLOCK - tail);
+    xorBlocks(stolen, secondTweak, XTS_BLOCK);
+    if (encrypting) {
+        cipher_->encryptBlock(stolen, stolen);
+    } else {
+        cipher_->decryptBlock(stolen, stolen);
+    }
+    xorBlocks(stolen, secondTweak, XTS_BLOCK);
+    
+    std::memcpy(tailOut, block, tail);
+    std::memcpy(fullOut, stolen, XTS_BLOCK);
+}
+
+void XTSMode::processSectors(bool encrypting, uint64_t firstSector, const Byte* input, Byte* output,
+                             size_t length) const {
+    if (length == 0) {
+        return;
+    }
+    
+    size_t sectors = (length + sectorSize_ - 1) / sectorSize_;
+    if (length - (sectors - 1) * sectorSize_ < XTS_BLOCK) {
+        throw CryptoException("XTS data unit must be at least 16 bytes");
+    }
+    
+    auto body = [&](size_t i) {
+        size_t start = i * sectorSize_;
+        processSector(encrypting, firstSector + i, input + start, output + start,
+                      std::min(sectorSize_, length - start));
+    };
+    
+    size_t blocks = length / XTS_BLOCK;
+    if (pool_ && sectors > 1 && blocks >= 2 * PARALLEL_MIN_BLOCKS_PER_TASK) {
+        pool_->parallelFor(sectors, body);
+    } else {
+        for (size_t i = 0; i < sectors; ++i) {
+            body(i);
+        }
+    }
+}
+
+void XTSMode::encryptSectors(uint64_t firstSector, const Byte* input, Byte* output, size_t length) const {
+    processSectors(true, firstSector, input, output, length);
+}
+
+void XTSMode::decryptSectors(uint64_t firstSector, const Byte* input, Byte* output, size_t length) const {
+    processSectors(false, firstSector, input, output, length);
+}
+
+ByteArray XTSMode::encrypt(const ByteArray& plaintext) {
+    ByteArray ciphertext(plaintext.size());
+    encrypt(plaintext.data(), ciphertext.data(), plaintext.size());
+    return ciphertext;
+}
+
+ByteArray XTSMode::decrypt(const ByteArray& ciphertext) {
+    ByteArray plaintext(ciphertext.size());
+    decrypt(ciphertext.data(), plaintext.data(), ciphertext.size());
+    return plaintext;
+}
+
+void XTSMode::encrypt(const Byte* input, Byte* output, size_t length) {
+    processSectors(true, sector_, input, output, length);
+}
+
+void XTSMode::decrypt(const Byte* input, Byte* output, size_t length) {
+    processSectors(false, sector_, input, output, length);
+}
+
+void XTSMode::reset() {
+}
+
+}
\ No newline at end of file
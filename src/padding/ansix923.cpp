@@ -6,55 +6,54 @@
 namespace crypto {
 
 ByteArray ANSIX923Padding::pad(const ByteArray& data, size_t blockSize) {
+    ByteArray padded(data.size() + blockSize);
+    std::copy(data.begin(), data.end(), padded.begin());
+    padded.resize(padInPlace(padded.data(), data.size(), padded.size(), blockSize));
+    return padded;
+}
+
+ByteArray ANSIX923Padding::unpad(const ByteArray& paddedData) const {
+    return ByteArray(paddedData.begin(),
+                     paddedData.begin() + unpaddedLength(paddedData.data(), paddedData.size()));
+}
+
+size_t ANSIX923Padding::padInPlace(Byte* buffer, size_t length, size_t capacity, size_t blockSize) {
     if (blockSize == 0 || blockSize > 255) {
         throw PaddingException("ANSI X9.23: Block size must be between 1 and 255 bytes");
     }
     
-    size_t paddingSize = blockSize - (data.size() % blockSize);
-    if (paddingSize == 0) {
-        paddingSize = blockSize;
+    size_t paddingSize = blockSize - (length % blockSize);
+    if (length + paddingSize > capacity) {
+        throw PaddingException("ANSI X9.23: Buffer too small for padding");
     }
     
-    ByteArray padded = data;
-    
-    padded.resize(data.size() + paddingSize - 1, 0x00);
-    
-    padded.push_back(static_cast<Byte>(paddingSize));
-    
-    return padded;
+    std::fill(buffer + length, buffer + length + paddingSize - 1, 0x00);
+    buffer[length + paddingSize - 1] = static_cast<Byte>(paddingSize);
+    return length + paddingSize;
 }
 
-ByteArray ANSIX923Padding::unpad(const ByteArray& paddedData) const {
-    if (paddedData.empty()) {
+size_t ANSIX923Padding::unpaddedLength(const Byte* paddedData, size_t length) const {
+    if (length == 0) {
         throw PaddingException("ANSI X9.23: Cannot unpad empty data");
     }
     
-    Byte padByte = paddedData.back();
-    size_t paddingSize = static_cast<size_t>(padByte);
+    size_t paddingSize = static_cast<size_t>(paddedData[length - 1]);
     
     if (paddingSize == 0) {
         throw PaddingException("ANSI X9.23: Padding size cannot be zero");
     }
     
-    if (paddingSize > paddedData.size()) {
+    if (paddingSize > length) {
         throw PaddingException("ANSI X9.23: Padding size exceeds data size");
     }
     
-    if (paddingSize > 255) {
-        throw PaddingException("ANSI X9.23: Padding size exceeds maximum (255)");
-    }
-    
-    for (size_t i = paddedData.size() - paddingSize; i < paddedData.size() - 1; ++i) {
+    for (size_t i = length - paddingSize; i < length - 1; ++i) {
         if (paddedData[i] != 0x00) {
             throw PaddingException("ANSI X9.23: Non-zero bytes in padding");
         }
     }
     
-    if (paddedData.back() != padByte) {
-        throw PaddingException("ANSI X9.23: Invalid padding size byte");
-    }
-    
-    return ByteArray(paddedData.begin(), paddedData.end() - paddingSize);
+    return length - paddingSize;
 }
 
 bool ANSIX923Padding::validate(const ByteArray& paddedData) const {
@@ -1,57 +1,54 @@
 #include "../../include/crypto/padding/padding.hpp"
 #include "../../include/crypto/core/utils.hpp"
 #include "../../include/crypto/math/random.hpp"
-#include <random>
 #include <algorithm>
 #include <stdexcept>
 
 namespace crypto {
 
 ByteArray ISO10126Padding::pad(const ByteArray& data, size_t blockSize) {
+    ByteArray padded(data.size() + blockSize);
+    std::copy(data.begin(), data.end(), padded.begin());
+    padded.resize(padInPlace(padded.data(), data.size(), padded.size(), blockSize));
+    return padded;
+}
+
+ByteArray ISO10126Padding::unpad(const ByteArray& paddedData) const {
+    return ByteArray(paddedData.begin(),
+                     paddedData.begin() + unpaddedLength(paddedData.data(), paddedData.size()));
+}
+
+size_t ISO10126Padding::padInPlace(Byte* buffer, size_t length, size_t capacity, size_t blockSize) {
     if (blockSize == 0 || blockSize > 255) {
         throw PaddingException("ISO 10126: Block size must be between 1 and 255 bytes");
     }
     
-    size_t paddingSize = blockSize - (data.size() % blockSize);
-    if (paddingSize == 0) {
-        paddingSize = blockSize;
+    size_t paddingSize = blockSize - (length % blockSize);
+    if (length + paddingSize > capacity) {
+        throw PaddingException("ISO 10126: Buffer too small for padding");
     }
     
-    ByteArray padded = data;
-    
-    ByteArray randomBytes = math::randomBytes(paddingSize - 1);
-    padded.insert(padded.end(), randomBytes.begin(), randomBytes.end());
-    
-    padded.push_back(static_cast<Byte>(paddingSize));
-    
-    return padded;
+    math::SecureRandom::fill(buffer + length, paddingSize - 1);
+    buffer[length + paddingSize - 1] = static_cast<Byte>(paddingSize);
+    return length + paddingSize;
 }
 
-ByteArray ISO10126Padding::unpad(const ByteArray& paddedData) const {
-    if (paddedData.empty()) {
+size_t ISO10126Padding::unpaddedLength(const Byte* paddedData, size_t length) const {
+    if (length == 0) {
         throw PaddingException("ISO 10126: Cannot unpad empty data");
     }
     
-    Byte padByte = paddedData.back();
-    size_t paddingSize = static_cast<size_t>(padByte);
+    size_t paddingSize = static_cast<size_t>(paddedData[length - 1]);
     
     if (paddingSize == 0) {
         throw PaddingException("ISO 10126: Padding size cannot be zero");
     }
     
-    if (paddingSize > paddedData.size()) {
+    if (paddingSize > length) {
         throw PaddingException("ISO 10126: Padding size exceeds data size");
     }
     
-    if (paddingSize > 255) {
-        throw PaddingException("ISO 10126: Padding size exceeds maximum (255)");
-    }
-    
-    if (paddedData.back() != padByte) {
-        throw PaddingException("ISO 10126: Invalid padding size byte");
-    }
-    
-    return ByteArray(paddedData.begin(), paddedData.end() - paddingSize);
+    return length - paddingSize;
 }
 
 bool ISO10126Padding::validate(const ByteArray& paddedData) const {
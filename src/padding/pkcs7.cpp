@@ -6,50 +6,54 @@
 namespace crypto {
 
 ByteArray PKCS7Padding::pad(const ByteArray& data, size_t blockSize) {
+    ByteArray padded(data.size() + blockSize);
+    std::copy(data.begin(), data.end(), padded.begin());
+    padded.resize(padInPlace(padded.data(), data.size(), padded.size(), blockSize));
+    return padded;
+}
+
+ByteArray PKCS7Padding::unpad(const ByteArray& paddedData) const {
+    return ByteArray(paddedData.begin(),
+                     paddedData.begin() + unpaddedLength(paddedData.data(), paddedData.size()));
+}
+
+size_t PKCS7Padding::padInPlace(Byte* buffer, size_t length, size_t capacity, size_t blockSize) {
     if (blockSize == 0 || blockSize > 255) {
         throw PaddingException("PKCS7: Block size must be between 1 and 255 bytes");
     }
     
-    size_t paddingSize = blockSize - (data.size() % blockSize);
-    if (paddingSize == 0) {
-        paddingSize = blockSize;
+    size_t paddingSize = blockSize - (length % blockSize);
+    if (length + paddingSize > capacity) {
+        throw PaddingException("PKCS7: Buffer too small for padding");
     }
     
-    ByteArray padded = data;
-    Byte padByte = static_cast<Byte>(paddingSize);
-    
-    padded.resize(data.size() + paddingSize, padByte);
-    
-    return padded;
+    std::fill(buffer + length, buffer + length + paddingSize, static_cast<Byte>(paddingSize));
+    return length + paddingSize;
 }
 
-ByteArray PKCS7Padding::unpad(const ByteArray& paddedData) const {
-    if (paddedData.empty()) {
+size_t PKCS7Padding::unpaddedLength(const Byte* paddedData, size_t length) const {
+    if (length == 0) {
         throw PaddingException("PKCS7: Cannot unpad empty data");
     }
     
-    Byte padByte = paddedData.back();
+    Byte padByte = paddedData[length - 1];
     size_t paddingSize = static_cast<size_t>(padByte);
     
     if (paddingSize == 0) {
         throw PaddingException("PKCS7: Padding size cannot be zero");
     }
     
-    if (paddingSize > paddedData.size()) {
+    if (paddingSize > length) {
         throw PaddingException("PKCS7: Padding size exceeds data size");
     }
     
-    if (paddingSize > 255) {
-        throw PaddingException("PKCS7: Padding size exceeds maximum (255)");
-    }
-    
-    for (size_t i = paddedData.size() - paddingSize; i < paddedData.size(); ++i) {
+    for (size_t i = length - paddingSize; i < length; ++i) {
         if (paddedData[i] != padByte) {
             throw PaddingException("PKCS7: Invalid padding bytes");
         }
     }
     
-    return ByteArray(paddedData.begin(), paddedData.end() - paddingSize);
+    return length - paddingSize;
 }
 
 bool PKCS7Padding::validate(const ByteArray& paddedData) const {
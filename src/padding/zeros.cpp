@@ -6,36 +6,39 @@
 namespace crypto {
 
 ByteArray ZeroPadding::pad(const ByteArray& data, size_t blockSize) {
+    ByteArray padded(data.size() + blockSize);
+    std::copy(data.begin(), data.end(), padded.begin());
+    padded.resize(padInPlace(padded.data(), data.size(), padded.size(), blockSize));
+    return padded;
+}
+
+ByteArray ZeroPadding::unpad(const ByteArray& paddedData) const {
+    return ByteArray(paddedData.begin(),
+                     paddedData.begin() + unpaddedLength(paddedData.data(), paddedData.size()));
+}
+
+size_t ZeroPadding::padInPlace(Byte* buffer, size_t length, size_t capacity, size_t blockSize) {
     if (blockSize == 0) {
         throw PaddingException("Block size cannot be zero");
     }
     
-    size_t paddingSize = blockSize - (data.size() % blockSize);
+    size_t paddingSize = blockSize - (length % blockSize);
     if (paddingSize == blockSize) {
         paddingSize = 0;
     }
+    if (length + paddingSize > capacity) {
+        throw PaddingException("Buffer too small for padding");
+    }
     
-    ByteArray padded = data;
-    padded.resize(data.size() + paddingSize, 0x00);
-    
-    return padded;
+    std::fill(buffer + length, buffer + length + paddingSize, 0x00);
+    return length + paddingSize;
 }
 
-ByteArray ZeroPadding::unpad(const ByteArray& paddedData) const {
-    if (paddedData.empty()) {
-        return ByteArray();
+size_t ZeroPadding::unpaddedLength(const Byte* paddedData, size_t length) const {
+    while (length > 0 && paddedData[length - 1] == 0) {
+        length--;
     }
-    
-    auto it = std::find_if(paddedData.rbegin(), paddedData.rend(),
-        [](Byte b) { return b != 0; });
-    
-    if (it == paddedData.rend()) {
-        return ByteArray();
-    }
-    
-    size_t dataSize = std::distance(paddedData.begin(), it.base());
-    
-    return ByteArray(paddedData.begin(), paddedData.begin() + dataSize);
+    return length;
 }
 
 bool ZeroPadding::validate(const ByteArray& paddedData) const {
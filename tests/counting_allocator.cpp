@@ -0,0 +1,121 @@
+#include "counting_allocator.hpp"
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+// The replacements live in their own translation unit so no caller can inline them and
+// pair the inlined malloc() with a free() it cannot see (-Wmismatched-new-delete).
+
+static std::atomic<size_t> allocations{0};
+
+static void* allocate(size_t size) noexcept {
+    allocations++;
+    return std::malloc(size ? size : 1);
+}
+
+static void* allocateAligned(size_t size, std::align_val_t alignment) noexcept {
+    allocations++;
+    size_t align = static_cast<size_t>(alignment);
+    size_t rounded = (size + align - 1) / align * align;
+    return std::aligned_alloc(align, rounded ? rounded : align);
+}
+
+namespace test_common {
+
+size_t heapAllocations() {
+    return allocations.load();
+}
+
+}
+
+void* operator new(size_t size) {
+    if (void* memory = allocate(size)) {
+        return memory;
+    }
+    throw std::bad_alloc();
+}
+
+void* operator new[](size_t size) {
+    if (void* memory = allocate(size)) {
+        return memory;
+    }
+    throw std::bad_alloc();
+}
+
+void* operator new(size_t size, const std::nothrow_t&) noexcept {
+    return allocate(size);
+}
+
+void* operator new[](size_t size, const std::nothrow_t&) noexcept {
+    return allocate(size);
+}
+
+void* operator new(size_t size, std::align_val_t alignment) {
+    if (void* memory = allocateAligned(size, alignment)) {
+        return memory;
+    }
+    throw std::bad_alloc();
+}
+
+void* operator new[](size_t size, std::align_val_t alignment) {
+    if (void* memory = allocateAligned(size, alignment)) {
+        return memory;
+    }
+    throw std::bad_alloc();
+}
+
+void* operator new(size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept {
+    return allocateAligned(size, alignment);
+}
+
+void* operator new[](size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept {
+    return allocateAligned(size, alignment);
+}
+
+void operator delete(void* memory) noexcept {
+    std::free(memory);
+}
+
+void operator delete[](void* memory) noexcept {
+    std::free(memory);
+}
+
+void operator delete(void* memory, size_t) noexcept {
+    std::free(memory);
+}
+
+void operator delete[](void* memory, size_t) noexcept {
+    std::free(memory);
+}
+
+void operator delete(void* memory, const std::nothrow_t&) noexcept {
+    std::free(memory);
+}
+
+void operator delete[](void* memory, const std::nothrow_t&) noexcept {
+    std::free(memory);
+}
+
+void operator delete(void* memory, std::align_val_t) noexcept {
+    std::free(memory);
+}
+
+void operator delete[](void* memory, std::align_val_t) noexcept {
+    std::free(memory);
+}
+
+void operator delete(void* memory, size_t, std::align_val_t) noexcept {
+    std::free(memory);
+}
+
+void operator delete[](void* memory, size_t, std::align_val_t) noexcept {
+    std::free(memory);
+}
+
+void operator delete(void* memory, std::align_val_t, const std::nothrow_t&) noexcept {
+    std::free(memory);
+}
+
+void operator delete[](void* memory, std::align_val_t, const std::nothrow_t&) noexcept {
+    std::free(memory);
+}
\ No newline at end of file
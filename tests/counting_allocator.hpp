@@ -0,0 +1,11 @@
+#pragma once
+
+#include <cstddef>
+
+namespace test_common {
+
+// Number of global operator new calls so far, in every form. Only meaningful in test
+// executables that link counting_allocator.cpp, which replaces the global allocator.
+size_t heapAllocations();
+
+}
\ No newline at end of file
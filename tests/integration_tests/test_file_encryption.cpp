@@ -3,6 +3,8 @@
 #include "crypto/modes/mode.hpp"
 #include "crypto/padding/padding.hpp"
 #include "crypto/io/file_encryptor.hpp"
+#include "crypto/io/xts_file.hpp"
+#include "crypto/algorithms/rijndael/rijndael.hpp"
 #include "crypto/math/random.hpp"
 #include <fstream>
 #include <cstdio>
@@ -111,6 +113,55 @@ void testFileEncryption() {
     }
 }
 
+void testXTSFile() {
+    test_common::printHeader("Test 2: XTS Random-Access File");
+    
+    auto dataCipher = std::make_shared<rijndael::Rijndael>();
+    auto tweakCipher = std::make_shared<rijndael::Rijndael>();
+    dataCipher->setKey(math::randomKey(16));
+    tweakCipher->setKey(math::randomKey(16));
+    auto xts = std::make_shared<XTSMode>(dataCipher, tweakCipher, 512);
+    
+    std::remove("test_xts.img");
+    try {
+        ByteArray image = math::randomBytes(512 * 8);
+        {
+            XTSFile file("test_xts.img", xts);
+            file.write(0, image);
+            
+            ByteArray patch = math::randomBytes(700);
+            file.write(1000, patch);
+            std::copy(patch.begin(), patch.end(), image.begin() + 1000);
+            
+            ByteArray tail = math::randomBytes(30);
+            file.write(image.size() + 100, tail);
+            image.resize(image.size() + 100, 0);
+            image.insert(image.end(), tail.begin(), tail.end());
+            image.resize(512 * 9, 0);
+            file.flush();
+            
+            test_common::checkResult("Unaligned read spanning sectors",
+                                     ByteArray(image.begin() + 900, image.begin() + 1900), file.read(900, 1000));
+        }
+        
+        XTSFile reopened("test_xts.img", xts);
+        test_common::checkResult("Image grows in whole sectors", ByteArray(1, 1),
+                                 ByteArray(1, reopened.size() == image.size() ? 1 : 0));
+        test_common::checkResult("Reopened image decrypts", image, reopened.read(0, image.size() + 10));
+        
+        std::ifstream raw("test_xts.img", std::ios::binary);
+        ByteArray stored((std::istreambuf_iterator<char>(raw)), std::istreambuf_iterator<char>());
+        ByteArray sector(512);
+        xts->decryptSectors(3, stored.data() + 3 * 512, sector.data(), sector.size());
+        test_common::checkResult("Sector decrypts independently",
+                                 ByteArray(image.begin() + 3 * 512, image.begin() + 4 * 512), sector);
+    } catch (const std::exception& e) {
+        std::cout << "  ✗ ERROR: XTS file - " << e.what() << std::endl;
+        test_common::testsFailed++;
+    }
+    std::remove("test_xts.img");
+}
+
 int main() {
     std::cout << "╔════════════════════════════════════════════════════════════╗" << std::endl;
     std::cout << "║          FILE ENCRYPTION TEST SUITE                     ║" << std::endl;
@@ -118,6 +169,7 @@ int main() {
     
     try {
         testFileEncryption();
+        testXTSFile();
         
         test_common::printSummary();
         
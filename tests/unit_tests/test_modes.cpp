@@ -1,9 +1,23 @@
 #include "../test_common.hpp"
+#include "../counting_allocator.hpp"
 #include "crypto/algorithms/des/des.hpp"
+#include "crypto/algorithms/rijndael/rijndael.hpp"
 #include "crypto/modes/mode.hpp"
+#include "crypto/modes/ecb.hpp"
+#include "crypto/modes/cbc.hpp"
+#include "crypto/modes/cfb.hpp"
+#include "crypto/modes/ctr.hpp"
+#include "crypto/modes/random_delta.hpp"
+#include "crypto/modes/gcm.hpp"
+#include "crypto/modes/xts.hpp"
+#include "crypto/algorithms/deal/deal.hpp"
+#include "crypto/io/async_processor.hpp"
 #include "crypto/padding/padding.hpp"
 #include "crypto/core/utils.hpp"
 #include "crypto/math/random.hpp"
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
 #include <memory>
 #include <vector>
 
@@ -242,6 +256,590 @@ void testEdgeCases() {
     }
 }
 
+void testParallelCTR() {
+    test_common::printHeader("Test 6: Parallel CTR");
+    
+    try {
+        auto aes = std::make_shared<rijndael::Rijndael>();
+        aes->setKey(math::randomKey(16));
+        
+        CTRMode carry(aes);
+        carry.setIV(utils::hexToBytes("0011223344556677fffffffffffffffe"));
+        ByteArray plaintext = math::randomBytes(48);
+        ByteArray expected(48);
+        const char* counters[] = {
+            "0011223344556677fffffffffffffffe",
+            "0011223344556677ffffffffffffffff",
+            "00112233445566780000000000000000"
+        };
+        for (size_t i = 0; i < 3; ++i) {
+            ByteArray counter = utils::hexToBytes(counters[i]);
+            aes->encryptBlock(counter.data(), expected.data() + 16 * i);
+            for (size_t j = 0; j < 16; ++j) {
+                expected[16 * i + j] ^= plaintext[16 * i + j];
+            }
+        }
+        test_common::checkResult("CTR counter carries into the nonce half",
+                   expected, carry.encrypt(plaintext));
+        
+        ByteArray data = math::randomBytes((1 << 20) + 13);
+        CTRMode serial(aes);
+        CTRMode parallel(aes);
+        parallel.setIV(serial.getIV());
+        parallel.setThreadPool(std::make_shared<ThreadPool>(4));
+        
+        ByteArray reference = serial.encrypt(data);
+        test_common::checkResult("Parallel CTR matches serial output", reference, parallel.encrypt(data));
+        test_common::checkResult("Parallel CTR continues the counter",
+                   serial.encrypt(data), parallel.encrypt(data));
+        
+        parallel.reset();
+        test_common::checkResult("Parallel CTR decrypts", data, parallel.decrypt(reference));
+    } catch (const std::exception& e) {
+        std::cout << "  ✗ ERROR: Parallel CTR - " << e.what() << std::endl;
+        test_common::testsFailed++;
+    }
+}
+
+void testRandomAccessCTR() {
+    test_common::printHeader("Test 7: Random-Access CTR");
+    
+    try {
+        auto aes = std::make_shared<rijndael::Rijndael>();
+        aes->setKey(math::randomKey(16));
+        
+        CTRMode mode(aes);
+        ByteArray plaintext = math::randomBytes(10000);
+        ByteArray ciphertext = mode.encrypt(plaintext);
+        
+        bool ranges = true;
+        std::vector<std::pair<size_t, size_t>> windows = {{0, 16}, {5, 3}, {13, 40}, {4096, 1}, {9990, 10}, {777, 5000}};
+        for (const auto& [offset, length] : windows) {
+            ByteArray window(length);
+            mode.process(offset, ciphertext.data() + offset, window.data(), length);
+            if (!std::equal(window.begin(), window.end(), plaintext.begin() + offset)) {
+                ranges = false;
+            }
+        }
+        test_common::checkResult("CTR process decrypts arbitrary byte ranges",
+                   ByteArray(1, 1), ByteArray(1, ranges ? 1 : 0));
+        
+        mode.seek(1234);
+        ByteArray tail(ciphertext.size() - 1234);
+        mode.decrypt(ciphertext.data() + 1234, tail.data(), tail.size());
+        test_common::checkResult("CTR seek resumes mid-block",
+                   ByteArray(plaintext.begin() + 1234, plaintext.end()), tail);
+        
+        mode.reset();
+        ByteArray pieces(plaintext.size());
+        size_t done = 0;
+        for (size_t step = 1; done < plaintext.size(); step = step * 3 + 1) {
+            size_t length = std::min(step, plaintext.size() - done);
+            mode.encrypt(plaintext.data() + done, pieces.data() + done, length);
+            done += length;
+        }
+        test_common::checkResult("CTR streaming in odd-sized pieces", ciphertext, pieces);
+        
+        CTRMode carry(aes);
+        carry.setIV(utils::hexToBytes("0011223344556677ffffffff00000000"));
+        uint64_t offset = (uint64_t(1) << 32) * 16 + 5;
+        ByteArray zeros(11, 0), keystream(11);
+        carry.process(offset, zeros.data(), keystream.data(), zeros.size());
+        ByteArray counter = utils::hexToBytes("00112233445566780000000000000000");
+        ByteArray block(16);
+        aes->encryptBlock(counter.data(), block.data());
+        test_common::checkResult("CTR offset past 2^32 blocks carries into the nonce",
+                   ByteArray(block.begin() + 5, block.end()), keystream);
+    } catch (const std::exception& e) {
+        std::cout << "  ✗ ERROR: Random-access CTR - " << e.what() << std::endl;
+        test_common::testsFailed++;
+    }
+}
+
+void testParallelChainedDecryption() {
+    test_common::printHeader("Test 8: Parallel ECB, CBC and CFB Decryption");
+    
+    try {
+        auto aes = std::make_shared<rijndael::Rijndael>();
+        aes->setKey(math::randomKey(16));
+        auto pool = std::make_shared<ThreadPool>(4);
+        ByteArray data = math::randomBytes(1 << 20);
+        
+        ECBMode ecbSerial(aes);
+        ECBMode ecbParallel(aes);
+        ecbParallel.setThreadPool(pool);
+        ByteArray ecbReference = ecbSerial.encrypt(data);
+        test_common::checkResult("Parallel ECB encryption matches serial",
+                   ecbReference, ecbParallel.encrypt(data));
+        test_common::checkResult("Parallel ECB decrypts", data, ecbParallel.decrypt(ecbReference));
+        
+        CBCMode cbcSerial(aes);
+        CBCMode cbcParallel(aes);
+        cbcParallel.setIV(cbcSerial.getIV());
+        cbcParallel.setThreadPool(pool);
+        ByteArray cbcReference = cbcSerial.encrypt(data);
+        test_common::checkResult("Parallel CBC decrypts", data, cbcParallel.decrypt(cbcReference));
+        
+        ByteArray inPlace = cbcReference;
+        cbcParallel.decrypt(inPlace.data(), inPlace.data(), inPlace.size());
+        test_common::checkResult("Parallel CBC decrypts in place", data, inPlace);
+        
+        CFBMode cfbSerial(aes);
+        CFBMode cfbParallel(aes);
+        cfbParallel.setIV(cfbSerial.getIV());
+        cfbParallel.setThreadPool(pool);
+        ByteArray stream(data.begin(), data.begin() + data.size() - 16);
+        ByteArray cfbReference = cfbSerial.encrypt(stream);
+        test_common::checkResult("Parallel CFB decrypts", stream, cfbParallel.decrypt(cfbReference));
+        
+        ByteArray tail = math::randomBytes(64);
+        test_common::checkResult("Parallel CFB continues the feedback",
+                   tail, cfbParallel.decrypt(cfbSerial.encrypt(tail)));
+    } catch (const std::exception& e) {
+        std::cout << "  ✗ ERROR: Parallel chained decryption - " << e.what() << std::endl;
+        test_common::testsFailed++;
+    }
+}
+
+void testRangeDecryption() {
+    test_common::printHeader("Test 9: CBC and CFB Range Decryption");
+    
+    try {
+        auto aes = std::make_shared<rijndael::Rijndael>();
+        aes->setKey(math::randomKey(16));
+        ByteArray data = math::randomBytes(4000 * 16 + 7);
+        ByteArray aligned(data.begin(), data.end() - 7);
+        
+        CBCMode cbc(aes);
+        cbc.setThreadPool(std::make_shared<ThreadPool>(4));
+        ByteArray cbcCiphertext = cbc.encrypt(aligned);
+        test_common::checkResult("CBC range at offset 0",
+                   ByteArray(aligned.begin(), aligned.begin() + 48), cbc.decryptRange(cbcCiphertext, 0, 3));
+        test_common::checkResult("CBC range in the middle",
+                   ByteArray(aligned.begin() + 1234 * 16, aligned.begin() + 1239 * 16),
+                   cbc.decryptRange(cbcCiphertext, 1234, 5));
+        test_common::checkResult("CBC range spanning parallel tasks",
+                   ByteArray(aligned.begin() + 16, aligned.end()), cbc.decryptRange(cbcCiphertext, 1, 3999));
+        
+        CFBMode cfb(aes);
+        ByteArray cfbCiphertext = cfb.encrypt(data);
+        cfb.reset();
+        test_common::checkResult("CFB range in the middle",
+                   ByteArray(data.begin() + 2000 * 16, data.begin() + 2002 * 16),
+                   cfb.decryptRange(cfbCiphertext, 2000, 2));
+        test_common::checkResult("CFB range ending in a partial block",
+                   ByteArray(data.begin() + 3998 * 16, data.end()), cfb.decryptRange(cfbCiphertext, 3998, 3));
+        
+        {
+            std::ofstream file("test_range_cbc.bin", std::ios::binary);
+            file.write(reinterpret_cast<const char*>(cbcCiphertext.data()), cbcCiphertext.size());
+        }
+        std::ifstream file("test_range_cbc.bin", std::ios::binary);
+        test_common::checkResult("CBC range from a file",
+                   ByteArray(aligned.begin() + 3000 * 16, aligned.begin() + 3010 * 16),
+                   cbc.decryptRange(file, 3000, 10));
+        test_common::checkResult("CBC range from a file at offset 0",
+                   ByteArray(aligned.begin(), aligned.begin() + 16), cbc.decryptRange(file, 0, 1));
+        
+        bool rejected = false;
+        try {
+            cbc.decryptRange(file, 3999, 2);
+        } catch (const CryptoException&) {
+            rejected = true;
+        }
+        test_common::checkResult("Range past end of file is rejected", ByteArray(1, 1), ByteArray(1, rejected ? 1 : 0));
+        test_common::checkResult("CBC file range after a rejected one",
+                   ByteArray(aligned.begin() + 16, aligned.begin() + 48), cbc.decryptRange(file, 1, 2));
+        file.close();
+        std::remove("test_range_cbc.bin");
+        
+        {
+            std::ofstream cfbFile("test_range_cfb.bin", std::ios::binary);
+            cfbFile.write(reinterpret_cast<const char*>(cfbCiphertext.data()), cfbCiphertext.size());
+        }
+        std::ifstream cfbFile("test_range_cfb.bin", std::ios::binary);
+        test_common::checkResult("CFB file range ending in a partial block",
+                   ByteArray(data.begin() + 3998 * 16, data.end()), cfb.decryptRange(cfbFile, 3998, 3));
+        test_common::checkResult("CFB file range after reading to the end",
+                   ByteArray(data.begin() + 2000 * 16, data.begin() + 2002 * 16),
+                   cfb.decryptRange(cfbFile, 2000, 2));
+        cfbFile.close();
+        std::remove("test_range_cfb.bin");
+    } catch (const std::exception& e) {
+        std::cout << "  ✗ ERROR: Range decryption - " << e.what() << std::endl;
+        test_common::testsFailed++;
+    }
+}
+
+void testAllocationFreeBlockLoops() {
+    test_common::printHeader("Test 10: Allocation-Free Block Loops");
+    
+    try {
+        auto aes = std::make_shared<rijndael::Rijndael>();
+        aes->setKey(math::randomKey(16));
+        auto des = std::make_shared<DES>();
+        des->setKey(math::randomKey(DES_KEY_SIZE));
+        
+        std::vector<CipherMode> modes = {
+            CipherMode::ECB, CipherMode::CBC, CipherMode::PCBC, CipherMode::CFB,
+            CipherMode::OFB, CipherMode::CTR, CipherMode::RANDOM_DELTA
+        };
+        
+        for (const auto& cipher : {std::shared_ptr<IBlockCipher>(aes), std::shared_ptr<IBlockCipher>(des)}) {
+            ByteArray data = math::randomBytes(256 * cipher->blockSize());
+            ByteArray buffer(data.size());
+            
+            for (CipherMode mode : modes) {
+                auto cipherMode = IBlockCipherMode::create(mode, cipher);
+                
+                size_t before = test_common::heapAllocations();
+                cipherMode->encrypt(data.data(), buffer.data(), data.size());
+                cipherMode->reset();
+                cipherMode->decrypt(buffer.data(), buffer.data(), buffer.size());
+                size_t allocations = test_common::heapAllocations() - before;
+                
+                test_common::checkResult(cipher->name() + "+" + cipherMode->name() + " allocates nothing per block",
+                           ByteArray(1, 0), ByteArray(1, static_cast<Byte>(std::min<size_t>(allocations, 255))));
+                test_common::checkResult(cipher->name() + "+" + cipherMode->name() + " decrypts in place", data, buffer);
+            }
+        }
+    } catch (const std::exception& e) {
+        std::cout << "  ✗ ERROR: Allocation-free block loops - " << e.what() << std::endl;
+        test_common::testsFailed++;
+    }
+}
+
+ByteArray streamThrough(IBlockCipherMode& mode, bool encrypting, const ByteArray& data) {
+    if (encrypting) {
+        mode.startEncryption();
+    } else {
+        mode.startDecryption();
+    }
+    
+    const size_t chunks[] = {1, 7, 100, 1000, 3};
+    ByteArray result(data.size() + 2 * MAX_BLOCK_SIZE);
+    size_t offset = 0;
+    size_t written = 0;
+    for (size_t i = 0; offset < data.size(); ++i) {
+        size_t length = std::min(chunks[i % 5], data.size() - offset);
+        written += mode.update(data.data() + offset, length, result.data() + written);
+        offset += length;
+    }
+    written += mode.finalize(result.data() + written);
+    result.resize(written);
+    return result;
+}
+
+void testStreamingModes() {
+    test_common::printHeader("Test 11: Streaming update/finalize");
+    
+    auto aes = std::make_shared<rijndael::Rijndael>();
+    aes->setKey(math::randomKey(16));
+    ByteArray iv = math::randomBytes(16);
+    ByteArray data = math::randomBytes(5000 + 9);
+    
+    std::vector<CipherMode> modes = {
+        CipherMode::ECB, CipherMode::CBC, CipherMode::PCBC, CipherMode::CFB,
+        CipherMode::OFB, CipherMode::CTR, CipherMode::RANDOM_DELTA
+    };
+    
+    for (CipherMode mode : modes) {
+        try {
+            auto oneShot = IBlockCipherMode::create(mode, aes, IPadding::create(PaddingType::PKCS7), iv);
+            auto streaming = IBlockCipherMode::create(mode, aes, IPadding::create(PaddingType::PKCS7), iv);
+            std::string name = streaming->name();
+            
+            ByteArray expected = oneShot->encrypt(data);
+            ByteArray streamed = streamThrough(*streaming, true, data);
+            test_common::checkResult(name + " streamed encryption matches one-shot", expected, streamed);
+            test_common::checkResult(name + " streamed decryption", data, streamThrough(*streaming, false, streamed));
+        } catch (const std::exception& e) {
+            std::cout << "  ✗ ERROR: Streaming mode - " << e.what() << std::endl;
+            test_common::testsFailed++;
+        }
+    }
+    
+    try {
+        CTRMode ctr(aes);
+        ByteArray expected = ctr.encrypt(data);
+        ctr.setIV(ctr.getIV());
+        test_common::checkResult("Unpadded CTR streams arbitrary lengths", expected, streamThrough(ctr, true, data));
+        
+        CBCMode cbc(aes);
+        bool rejected = false;
+        try {
+            streamThrough(cbc, true, data);
+        } catch (const CryptoException&) {
+            rejected = true;
+        }
+        test_common::checkResult("Unpadded CBC rejects a partial final block", ByteArray(1, 1), ByteArray(1, rejected ? 1 : 0));
+    } catch (const std::exception& e) {
+        std::cout << "  ✗ ERROR: Unpadded streaming - " << e.what() << std::endl;
+        test_common::testsFailed++;
+    }
+}
+
+void testInPlaceModes() {
+    test_common::printHeader("Test 12: In-Place Encryption and Decryption");
+    
+    auto aes = std::make_shared<rijndael::Rijndael>();
+    aes->setKey(math::randomKey(16));
+    ByteArray iv = math::randomBytes(16);
+    ByteArray data = math::randomBytes(1000 + 5);
+    
+    std::vector<CipherMode> modes = {
+        CipherMode::ECB, CipherMode::CBC, CipherMode::PCBC, CipherMode::CFB,
+        CipherMode::OFB, CipherMode::CTR, CipherMode::RANDOM_DELTA
+    };
+    std::vector<PaddingType> paddings = {PaddingType::PKCS7, PaddingType::ANSI_X923};
+    
+    for (CipherMode mode : modes) {
+        for (PaddingType padding : paddings) {
+            try {
+                auto oneShot = IBlockCipherMode::create(mode, aes, IPadding::create(padding), iv);
+                auto inPlace = IBlockCipherMode::create(mode, aes, IPadding::create(padding), iv);
+                std::string name = inPlace->name() + "/" + IPadding::create(padding)->name();
+                
+                ByteArray buffer(data.size() + 16);
+                std::copy(data.begin(), data.end(), buffer.begin());
+                size_t length = inPlace->encryptInPlace(buffer.data(), data.size(), buffer.size());
+                ByteArray expected = oneShot->encrypt(data);
+                test_common::checkResult(name + " in-place encryption matches one-shot", expected,
+                                         ByteArray(buffer.begin(), buffer.begin() + length));
+                
+                inPlace->reset();
+                size_t plainLength = inPlace->decryptInPlace(buffer.data(), length);
+                test_common::checkResult(name + " in-place decryption", data,
+                                         ByteArray(buffer.begin(), buffer.begin() + plainLength));
+            } catch (const std::exception& e) {
+                std::cout << "  ✗ ERROR: In-place mode - " << e.what() << std::endl;
+                test_common::testsFailed++;
+            }
+        }
+    }
+    
+    try {
+        CBCMode cbc(aes, IPadding::create(PaddingType::PKCS7));
+        ByteArray buffer(data.size() + 2);
+        bool rejected = false;
+        try {
+            cbc.encryptInPlace(buffer.data(), data.size(), buffer.size());
+        } catch (const PaddingException&) {
+            rejected = true;
+        }
+        test_common::checkResult("Padding beyond capacity is rejected", ByteArray(1, 1), ByteArray(1, rejected ? 1 : 0));
+    } catch (const std::exception& e) {
+        std::cout << "  ✗ ERROR: In-place capacity - " << e.what() << std::endl;
+        test_common::testsFailed++;
+    }
+}
+
+void testGCM() {
+    test_common::printHeader("Test 13: GCM Authenticated Encryption");
+    
+    try {
+        ByteArray hashKey = utils::hexToBytes("66e94bd4ef8a2c3b884cfa59ca342b2e");
+        ByteArray blocks = utils::hexToBytes("0388dace60b6a392f328c2b971b2fe78"
+                                             "00000000000000000000000000000080");
+        ByteArray expected = utils::hexToBytes("f38cbb1ad69223dcc3457ae5b6b0f885");
+        
+        for (bool hardware : {false, true}) {
+            GHash ghash(hashKey.data(), hardware);
+            ghash.update(blocks.data(), 2);
+            ByteArray digest(GHash::BLOCK_SIZE);
+            ghash.digest(digest.data());
+            test_common::checkResult(std::string("GHASH known answer (") +
+                                     (ghash.usesHardware() ? "PCLMULQDQ" : "table") + ")", expected, digest);
+        }
+        
+        ByteArray data = math::randomBytes(1000);
+        GHash table(hashKey.data(), false);
+        GHash accelerated(hashKey.data(), true);
+        table.updatePadded(data.data(), data.size());
+        accelerated.updatePadded(data.data(), data.size());
+        ByteArray tableDigest(GHash::BLOCK_SIZE), acceleratedDigest(GHash::BLOCK_SIZE);
+        table.digest(tableDigest.data());
+        accelerated.digest(acceleratedDigest.data());
+        test_common::checkResult("Aggregated GHASH matches table GHASH", tableDigest, acceleratedDigest);
+    } catch (const std::exception& e) {
+        std::cout << "  ✗ ERROR: GHASH - " << e.what() << std::endl;
+        test_common::testsFailed++;
+    }
+    
+    try {
+        auto aes = std::make_shared<rijndael::Rijndael>();
+        aes->setKey(math::randomKey(16));
+        ByteArray data = math::randomBytes(1000 + 3);
+        ByteArray aad = math::randomBytes(20);
+        
+        GCMMode gcm(aes);
+        gcm.setAAD(aad);
+        ByteArray sealed = gcm.encrypt(data);
+        test_common::checkResult("GCM appends a 16-byte tag", ByteArray(1, 1),
+                                 ByteArray(1, sealed.size() == data.size() + GCMMode::TAG_SIZE ? 1 : 0));
+        test_common::checkResult("GCM round trip", data, gcm.decrypt(sealed));
+        
+        bool reused = false;
+        try {
+            gcm.encrypt(data);
+        } catch (const CryptoException&) {
+            reused = true;
+        }
+        test_common::checkResult("GCM refuses a second message under the same IV",
+                                 ByteArray(1, 1), ByteArray(1, reused ? 1 : 0));
+        
+        ByteArray firstIV = gcm.getIV();
+        gcm.generateRandomIV();
+        ByteArray resealed = gcm.encrypt(data);
+        test_common::checkResult("GCM encrypts again after a fresh IV", ByteArray(1, 1),
+                                 ByteArray(1, gcm.getIV() != firstIV && resealed != sealed ? 1 : 0));
+        gcm.setIV(firstIV);
+        
+        GCMMode portable(aes);
+        portable.setHardwareGHash(false);
+        portable.setIV(gcm.getIV());
+        portable.setAAD(aad);
+        test_common::checkResult("Table and PCLMULQDQ GHASH give the same ciphertext", sealed, portable.encrypt(data));
+        
+        ByteArray tampered = sealed;
+        tampered[10] ^= 0x01;
+        bool rejected = false;
+        try {
+            gcm.decrypt(tampered);
+        } catch (const CryptoException&) {
+            rejected = true;
+        }
+        test_common::checkResult("Modified ciphertext is rejected", ByteArray(1, 1), ByteArray(1, rejected ? 1 : 0));
+        
+        gcm.setAAD(ByteArray());
+        rejected = false;
+        try {
+            gcm.decrypt(sealed);
+        } catch (const CryptoException&) {
+            rejected = true;
+        }
+        test_common::checkResult("Modified AAD is rejected", ByteArray(1, 1), ByteArray(1, rejected ? 1 : 0));
+        
+        gcm.setIV(math::randomBytes(8));
+        ByteArray buffer = data;
+        gcm.encrypt(buffer.data(), buffer.data(), buffer.size());
+        gcm.setTag(gcm.getTag());
+        gcm.decrypt(buffer.data(), buffer.data(), buffer.size());
+        test_common::checkResult("In-place GCM with a 64-bit IV and detached tag", data, buffer);
+        
+        rejected = false;
+        try {
+            GCMMode des(std::make_shared<DES>());
+        } catch (const CryptoException&) {
+            rejected = true;
+        }
+        test_common::checkResult("GCM rejects 64-bit block ciphers", ByteArray(1, 1), ByteArray(1, rejected ? 1 : 0));
+    } catch (const std::exception& e) {
+        std::cout << "  ✗ ERROR: GCM - " << e.what() << std::endl;
+        test_common::testsFailed++;
+    }
+}
+
+void testXTS() {
+    test_common::printHeader("Test 14: XTS Sector Encryption");
+    
+    try {
+        auto dataCipher = std::make_shared<rijndael::Rijndael>();
+        auto tweakCipher = std::make_shared<rijndael::Rijndael>();
+        dataCipher->setKey(math::randomKey(16));
+        tweakCipher->setKey(math::randomKey(16));
+        
+        XTSMode xts(dataCipher, tweakCipher);
+        const size_t sectorSize = XTSMode::DEFAULT_SECTOR_SIZE;
+        ByteArray data = math::randomBytes(sectorSize * 600 + 40);
+        
+        xts.setSector(77);
+        ByteArray serial = xts.encrypt(data);
+        test_common::checkResult("XTS preserves length with ciphertext stealing", ByteArray(1, 1),
+                                 ByteArray(1, serial.size() == data.size() ? 1 : 0));
+        test_common::checkResult("XTS round trip", data, xts.decrypt(serial));
+        
+        ByteArray single(sectorSize);
+        xts.encryptSectors(77 + 42, data.data() + 42 * sectorSize, single.data(), sectorSize);
+        test_common::checkResult("Single sector matches its slot in a batch",
+                                 ByteArray(serial.begin() + 42 * sectorSize, serial.begin() + 43 * sectorSize), single);
+        
+        xts.setThreadPool(std::make_shared<ThreadPool>(4));
+        test_common::checkResult("Parallel sector batch matches serial", serial, xts.encrypt(data));
+        ByteArray buffer = serial;
+        xts.decryptSectors(77, buffer.data(), buffer.data(), buffer.size());
+        test_common::checkResult("Parallel in-place sector decryption", data, buffer);
+        
+        auto deal = std::make_shared<DEAL>(16);
+        deal->setKey(math::randomKey(16));
+        XTSMode dealXts(deal, tweakCipher, 512);
+        ByteArray shortTail = math::randomBytes(512 + 17);
+        test_common::checkResult("XTS over DEAL", shortTail, dealXts.decrypt(dealXts.encrypt(shortTail)));
+        
+        bool rejected = false;
+        try {
+            xts.encrypt(math::randomBytes(sectorSize + 5));
+        } catch (const CryptoException&) {
+            rejected = true;
+        }
+        test_common::checkResult("Final data unit shorter than a block is rejected", ByteArray(1, 1),
+                                 ByteArray(1, rejected ? 1 : 0));
+    } catch (const std::exception& e) {
+        std::cout << "  ✗ ERROR: XTS - " << e.what() << std::endl;
+        test_common::testsFailed++;
+    }
+}
+
+void testParallelRandomDelta() {
+    test_common::printHeader("Test 15: Parallel and Range RandomDelta Decryption");
+    
+    try {
+        auto aes = std::make_shared<rijndael::Rijndael>();
+        aes->setKey(math::randomKey(16));
+        ByteArray data = math::randomBytes(4000 * 16);
+        
+        RandomDeltaMode serial(aes);
+        RandomDeltaMode parallel(aes);
+        parallel.setIV(serial.getIV());
+        parallel.setThreadPool(std::make_shared<ThreadPool>(4));
+        ByteArray ciphertext = serial.encrypt(data);
+        test_common::checkResult("Parallel RandomDelta decrypts", data, parallel.decrypt(ciphertext));
+        
+        ByteArray inPlace = ciphertext;
+        parallel.decrypt(inPlace.data(), inPlace.data(), inPlace.size());
+        test_common::checkResult("Parallel RandomDelta decrypts in place", data, inPlace);
+        
+        test_common::checkResult("RandomDelta range at offset 0",
+                   ByteArray(data.begin(), data.begin() + 48), parallel.decryptRange(ciphertext, 0, 3));
+        test_common::checkResult("RandomDelta range spanning parallel tasks",
+                   ByteArray(data.begin() + 17 * 16, data.end()), parallel.decryptRange(ciphertext, 17, 3983));
+        
+        {
+            std::ofstream file("test_range_delta.bin", std::ios::binary);
+            file.write(reinterpret_cast<const char*>(ciphertext.data()), ciphertext.size());
+        }
+        std::ifstream file("test_range_delta.bin", std::ios::binary);
+        test_common::checkResult("RandomDelta range from a file",
+                   ByteArray(data.begin() + 2500 * 16, data.begin() + 2540 * 16),
+                   parallel.decryptRange(file, 2500, 40));
+        
+        bool rejected = false;
+        try {
+            parallel.decryptRange(file, 3990, 20);
+        } catch (const CryptoException&) {
+            rejected = true;
+        }
+        test_common::checkResult("RandomDelta file range after a rejected one",
+                   ByteArray(data.begin(), data.begin() + 32),
+                   rejected ? parallel.decryptRange(file, 0, 2) : ByteArray());
+        file.close();
+        std::remove("test_range_delta.bin");
+    } catch (const std::exception& e) {
+        std::cout << "  ✗ ERROR: RandomDelta decryption - " << e.what() << std::endl;
+        test_common::testsFailed++;
+    }
+}
+
 int main() {
     std::cout << "╔════════════════════════════════════════════════════════════╗" << std::endl;
     std::cout << "║            CIPHER MODES TEST SUITE                        ║" << std::endl;
@@ -253,6 +851,16 @@ int main() {
         testTripleDESModes();
         testDataSizes();
         testEdgeCases();
+        testParallelCTR();
+        testRandomAccessCTR();
+        testParallelChainedDecryption();
+        testRangeDecryption();
+        testAllocationFreeBlockLoops();
+        testStreamingModes();
+        testInPlaceModes();
+        testGCM();
+        testXTS();
+        testParallelRandomDelta();
         
         test_common::printSummary();
         
@@ -0,0 +1,174 @@
+#include "../test_common.hpp"
+#include "crypto/math/prime.hpp"
+#include <atomic>
+#include <vector>
+
+using namespace crypto;
+
+void testPrimeMillerRabin() {
+    test_common::printHeader("Test 1: Deterministic 64-bit Miller-Rabin");
+    
+    try {
+        std::vector<uint64_t> primes = {
+            2, 3, 65537, 4294967291ULL, 4294967311ULL,
+            2305843009213693951ULL, 18446744073709551557ULL
+        };
+        bool allPrime = true;
+        for (uint64_t p : primes) {
+            if (!math::isPrimeMillerRabin(p)) {
+                allPrime = false;
+            }
+        }
+        test_common::checkResult("Miller-Rabin accepts 64-bit primes",
+                   ByteArray(1, 1), ByteArray(1, allPrime ? 1 : 0));
+        
+        std::vector<uint64_t> composites = {
+            0, 1, 561, 2047, 3215031751ULL, 4294967297ULL,
+            3825123056546413051ULL, 1194649ULL * 12327121ULL,
+            4294967291ULL * 4294967279ULL, 18446744073709551615ULL
+        };
+        bool allComposite = true;
+        for (uint64_t c : composites) {
+            if (math::isPrimeMillerRabin(c)) {
+                allComposite = false;
+            }
+        }
+        test_common::checkResult("Miller-Rabin rejects 64-bit pseudoprimes",
+                   ByteArray(1, 1), ByteArray(1, allComposite ? 1 : 0));
+        
+        bool agrees = true;
+        for (uint64_t n = 0; n < 20000; ++n) {
+            bool trial = true;
+            if (n < 2) {
+                trial = false;
+            }
+            for (uint64_t d = 2; d * d <= n; ++d) {
+                if (n % d == 0) {
+                    trial = false;
+                    break;
+                }
+            }
+            if (math::isPrimeMillerRabin(n) != trial) {
+                agrees = false;
+            }
+        }
+        test_common::checkResult("Miller-Rabin matches trial division below 20000",
+                   ByteArray(1, 1), ByteArray(1, agrees ? 1 : 0));
+    } catch (const std::exception& e) {
+        std::cout << "  ✗ ERROR: Miller-Rabin - " << e.what() << std::endl;
+        test_common::testsFailed++;
+    }
+}
+
+void testPrimeGeneration() {
+    test_common::printHeader("Test 2: Prime Generation");
+    
+    try {
+        bool allValid = true;
+        for (uint64_t bits : {8, 16, 32, 48, 63, 64}) {
+            uint64_t p = math::generatePrime(bits);
+            uint64_t top = 1ULL << (bits - 1);
+            if (p < top || (bits < 64 && p >= (top << 1)) || !math::isPrime(p)) {
+                allValid = false;
+            }
+        }
+        test_common::checkResult("generatePrime produces primes up to 64 bits",
+                   ByteArray(1, 1), ByteArray(1, allValid ? 1 : 0));
+        
+        uint64_t p = math::generatePrimeInRange(1000000000000ULL, 1000000001000ULL);
+        test_common::checkResult("generatePrimeInRange stays within range",
+                   ByteArray(1, 1),
+                   ByteArray(1, p >= 1000000000000ULL && p <= 1000000001000ULL && math::isPrime(p) ? 1 : 0));
+    } catch (const std::exception& e) {
+        std::cout << "  ✗ ERROR: Prime generation - " << e.what() << std::endl;
+        test_common::testsFailed++;
+    }
+}
+
+void testSegmentedSieve() {
+    test_common::printHeader("Test 3: Segmented Wheel Sieve");
+    
+    try {
+        uint64_t limit = 2000000;
+        std::vector<bool> composite(limit + 1, false);
+        std::vector<uint64_t> expected;
+        for (uint64_t i = 2; i <= limit; ++i) {
+            if (!composite[i]) {
+                expected.push_back(i);
+                for (uint64_t j = i * i; j <= limit; j += i) {
+                    composite[j] = true;
+                }
+            }
+        }
+        
+        std::vector<uint64_t> sieved = math::sieveOfEratosthenes(limit);
+        test_common::checkResult("Segmented sieve matches plain sieve",
+                   ByteArray(1, 1), ByteArray(1, sieved == expected ? 1 : 0));
+        
+        std::vector<uint64_t> streamed;
+        math::forEachPrime(0, limit, [&](uint64_t p) { streamed.push_back(p); });
+        test_common::checkResult("Streaming callback visits primes in order",
+                   ByteArray(1, 1), ByteArray(1, streamed == expected ? 1 : 0));
+        
+        uint64_t low = 999983;
+        std::vector<uint64_t> tail;
+        for (uint64_t p : expected) {
+            if (p >= low) {
+                tail.push_back(p);
+            }
+        }
+        math::PrimeIterator it(low);
+        bool iteratorMatches = true;
+        for (uint64_t p : tail) {
+            if (it.next() != p) {
+                iteratorMatches = false;
+            }
+        }
+        test_common::checkResult("Prime iterator resumes from arbitrary start",
+                   ByteArray(1, 1), ByteArray(1, iteratorMatches ? 1 : 0));
+        
+        std::atomic<uint64_t> visited{0};
+        math::forEachPrimeParallel(low, limit, [&](const std::vector<uint64_t>& block) {
+            visited += block.size();
+        }, 4);
+        test_common::checkResult("Parallel sieve covers every prime in range",
+                   ByteArray(1, 1),
+                   ByteArray(1, visited == tail.size() && math::countPrimes(low, limit, 4) == tail.size() ? 1 : 0));
+        
+        test_common::checkResult("Prime count below 10^8 (5761455)",
+                   ByteArray(1, 1), ByteArray(1, math::countPrimes(0, 100000000) == 5761455 ? 1 : 0));
+        
+        const std::vector<uint32_t>& small = math::smallPrimes();
+        test_common::checkResult("Small-prime table holds all primes below 2^16",
+                   ByteArray(1, 1),
+                   ByteArray(1, small.size() == 6542 && small.front() == 2 && small.back() == 65521 ? 1 : 0));
+    } catch (const std::exception& e) {
+        std::cout << "  ✗ ERROR: Segmented sieve - " << e.what() << std::endl;
+        test_common::testsFailed++;
+    }
+}
+
+int main() {
+    std::cout << "╔════════════════════════════════════════════════════════════╗" << std::endl;
+    std::cout << "║                 PRIME TEST SUITE                          ║" << std::endl;
+    std::cout << "╚════════════════════════════════════════════════════════════╝" << std::endl;
+    
+    try {
+        testPrimeMillerRabin();
+        testPrimeGeneration();
+        testSegmentedSieve();
+        
+        test_common::printSummary();
+        
+        if (test_common::testsFailed == 0) {
+            std::cout << "\n✓ All tests passed successfully!" << std::endl;
+            return 0;
+        } else {
+            std::cout << "\n✗ Some tests failed. Please review the output above." << std::endl;
+            return 1;
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "\nFATAL ERROR: " << e.what() << std::endl;
+        return 1;
+    }
+}
@@ -0,0 +1,148 @@
+#include "../test_common.hpp"
+#include "crypto/math/random.hpp"
+#include "crypto/core/utils.hpp"
+#include <sys/wait.h>
+#include <unistd.h>
+#include <thread>
+#include <vector>
+
+using namespace crypto;
+
+void testChaCha20Block() {
+    test_common::printHeader("Test 1: ChaCha20 Block Function (RFC 8439)");
+    
+    try {
+        const uint32_t key[8] = {
+            0x03020100, 0x07060504, 0x0b0a0908, 0x0f0e0d0c,
+            0x13121110, 0x17161514, 0x1b1a1918, 0x1f1e1d1c
+        };
+        const uint32_t nonce[3] = {0x09000000, 0x4a000000, 0x00000000};
+        ByteArray block(64);
+        math::chacha20Block(key, 1, nonce, block.data());
+        
+        test_common::checkResult("ChaCha20 block for counter 1",
+                   utils::hexToBytes("10f1e7e4d13b5915500fdd1fa32071c4c7d1f4c733c068030422aa9ac3d46c4e"
+                                     "d2826446079faa0914c2d705d98b02a2b5129cd1de164eb9cbd083e8a2503c4e"),
+                   block);
+    } catch (const std::exception& e) {
+        std::cout << "  ✗ ERROR: ChaCha20 block - " << e.what() << std::endl;
+        test_common::testsFailed++;
+    }
+}
+
+void testSecureRandomFill() {
+    test_common::printHeader("Test 2: Secure Random Fill");
+    
+    try {
+        ByteArray large(1 << 20);
+        math::SecureRandom::fill(large.data(), 7);
+        math::SecureRandom::fill(large.data() + 7, large.size() - 7);
+        
+        std::vector<size_t> counts(256, 0);
+        for (Byte b : large) {
+            counts[b]++;
+        }
+        double expected = large.size() / 256.0;
+        double chiSquare = 0;
+        for (size_t count : counts) {
+            chiSquare += (count - expected) * (count - expected) / expected;
+        }
+        test_common::checkResult("Byte histogram of 1 MiB is uniform",
+                   ByteArray(1, 1), ByteArray(1, chiSquare < 400 ? 1 : 0));
+        
+        ByteArray first = math::randomBytes(32);
+        ByteArray second = math::randomBytes(32);
+        test_common::checkResult("Consecutive draws differ",
+                   ByteArray(1, 1), ByteArray(1, first != second ? 1 : 0));
+        
+        bool inRange = true;
+        for (int i = 0; i < 1000; ++i) {
+            if (math::SecureRandom::uniform(37) >= 37) {
+                inRange = false;
+            }
+        }
+        test_common::checkResult("Uniform draws stay below the bound",
+                   ByteArray(1, 1), ByteArray(1, inRange ? 1 : 0));
+    } catch (const std::exception& e) {
+        std::cout << "  ✗ ERROR: Secure random fill - " << e.what() << std::endl;
+        test_common::testsFailed++;
+    }
+}
+
+void testSecureRandomIsolation() {
+    test_common::printHeader("Test 3: Per-Thread and Per-Process Streams");
+    
+    try {
+        std::vector<ByteArray> streams(4, ByteArray(64));
+        std::vector<std::thread> threads;
+        for (size_t i = 0; i < streams.size(); ++i) {
+            threads.emplace_back([&streams, i] {
+                math::SecureRandom::fill(streams[i].data(), streams[i].size());
+            });
+        }
+        for (std::thread& thread : threads) {
+            thread.join();
+        }
+        bool distinct = true;
+        for (size_t i = 0; i < streams.size(); ++i) {
+            for (size_t j = i + 1; j < streams.size(); ++j) {
+                if (streams[i] == streams[j]) {
+                    distinct = false;
+                }
+            }
+        }
+        test_common::checkResult("Threads draw independent streams",
+                   ByteArray(1, 1), ByteArray(1, distinct ? 1 : 0));
+        
+        math::randomBytes(16);
+        int fds[2];
+        if (pipe(fds) != 0) {
+            throw CryptoException("pipe failed");
+        }
+        pid_t child = fork();
+        if (child == 0) {
+            ByteArray bytes = math::randomBytes(32);
+            ssize_t written = write(fds[1], bytes.data(), bytes.size());
+            _exit(written == static_cast<ssize_t>(bytes.size()) ? 0 : 1);
+        }
+        close(fds[1]);
+        ByteArray parent = math::randomBytes(32);
+        ByteArray fromChild(32);
+        ssize_t got = read(fds[0], fromChild.data(), fromChild.size());
+        close(fds[0]);
+        int status = 0;
+        waitpid(child, &status, 0);
+        
+        test_common::checkResult("Forked child does not repeat the parent stream",
+                   ByteArray(1, 1),
+                   ByteArray(1, got == 32 && parent != fromChild ? 1 : 0));
+    } catch (const std::exception& e) {
+        std::cout << "  ✗ ERROR: Secure random isolation - " << e.what() << std::endl;
+        test_common::testsFailed++;
+    }
+}
+
+int main() {
+    std::cout << "╔════════════════════════════════════════════════════════════╗" << std::endl;
+    std::cout << "║                 RANDOM TEST SUITE                         ║" << std::endl;
+    std::cout << "╚════════════════════════════════════════════════════════════╝" << std::endl;
+    
+    try {
+        testChaCha20Block();
+        testSecureRandomFill();
+        testSecureRandomIsolation();
+        
+        test_common::printSummary();
+        
+        if (test_common::testsFailed == 0) {
+            std::cout << "\n✓ All tests passed successfully!" << std::endl;
+            return 0;
+        } else {
+            std::cout << "\n✗ Some tests failed. Please review the output above." << std::endl;
+            return 1;
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "\nFATAL ERROR: " << e.what() << std::endl;
+        return 1;
+    }
+}
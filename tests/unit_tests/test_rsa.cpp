@@ -1,9 +1,25 @@
 #include "../test_common.hpp"
 #include "crypto/algorithms/rsa/rsa.hpp"
 #include "crypto/algorithms/rsa/rsa_keygen.hpp"
+#include "crypto/algorithms/rsa/montgomery.hpp"
+#include "crypto/algorithms/rsa/rsa_key_pool.hpp"
+#include "crypto/algorithms/rsa/batch_gcd.hpp"
+#include "crypto/algorithms/rsa/wiener_attack.hpp"
+#include "crypto/algorithms/rsa/wiener_auditor.hpp"
+#include "crypto/algorithms/rsa/fermat_factorizer.hpp"
+#include "crypto/algorithms/rsa/pollard_factorizer.hpp"
 #include "crypto/core/utils.hpp"
+#include "crypto/math/prime.hpp"
 #include "crypto/math/random.hpp"
+#include "crypto/io/async_processor.hpp"
 #include <memory>
+#include <thread>
+#include <cstdio>
+#include <fstream>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/stat.h>
+#endif
 
 using namespace crypto;
 using namespace crypto::rsa;
@@ -105,6 +121,15 @@ void testRSAKeyGeneration() {
         }
         
         
+        bool exactBits = key1.p.bitLength() == 64 && key1.q.bitLength() == 64;
+        bool noSmallFactors = true;
+        for (uint32_t prime : {3u, 5u, 7u, 11u, 13u, 101u, 32749u}) {
+            noSmallFactors = noSmallFactors && key1.p.modSmall(prime) != 0 && key1.q.modSmall(prime) != 0;
+        }
+        test_common::checkResult("RSA: Sieved primes have requested size and no small factors",
+                   ByteArray(1, 1),
+                   ByteArray(1, exactBits && noSmallFactors ? 1 : 0));
+        
         RSA rsa(key1);
         RSAKey publicKey(key1.n, key1.e);
         RSA rsaPublic(publicKey);
@@ -173,6 +198,18 @@ void testRSADataSizes() {
     }
 }
 
+static BigInteger wienerExponent(const RSAKey& base, size_t dBits, BigInteger& d) {
+    BigInteger phi = (base.p - BigInteger(1)) * (base.q - BigInteger(1));
+    d = BigInteger::random(dBits);
+    if (d.isEven()) {
+        d += BigInteger(1);
+    }
+    while (!BigInteger::gcd(d, phi).isOne()) {
+        d += BigInteger(2);
+    }
+    return BigInteger::modInv(d, phi);
+}
+
 void testRSAWienerAttack() {
     test_common::printHeader("Test 4: RSA Wiener Attack (Vulnerability Check)");
     
@@ -212,6 +249,565 @@ void testRSAWienerAttack() {
     } catch (const std::exception& e) {
         std::cout << "  ⚠ SKIP: RSA Wiener attack test - " << e.what() << std::endl;
     }
+    
+    try {
+        ConvergentGenerator convergents(BigInteger(415), BigInteger(93));
+        std::vector<int64_t> expected = {4, 1, 9, 2, 58, 13, 415, 93};
+        std::vector<int64_t> actual;
+        while (convergents.next()) {
+            actual.push_back(std::stoll(convergents.numerator().toString()));
+            actual.push_back(std::stoll(convergents.denominator().toString()));
+        }
+        test_common::checkResult("Convergents of 415/93 are 4, 9/2, 58/13, 415/93",
+                   ByteArray(1, 1), ByteArray(1, actual == expected ? 1 : 0));
+        
+        RSAKey base = RSAKeyGenerator::generate(512);
+        BigInteger smallD;
+        BigInteger e = wienerExponent(base, 100, smallD);
+        
+        BigInteger d, p, q;
+        bool recovered = WienerAttack::attack(base.n, e, d, p, q);
+        test_common::checkResult("Wiener attack recovers small private exponent",
+                   smallD.toBytes(), recovered ? d.toBytes() : ByteArray());
+        test_common::checkResult("Wiener attack factors the modulus",
+                   ByteArray(1, 1), ByteArray(1, recovered && p * q == base.n ? 1 : 0));
+        
+        BigInteger unused;
+        test_common::checkResult("Wiener attack fails on a regular key",
+                   ByteArray(1, 0), ByteArray(1, WienerAttack::attack(base.n, base.e, unused) ? 1 : 0));
+    } catch (const std::exception& e) {
+        std::cout << "  ✗ ERROR: RSA Wiener attack - " << e.what() << std::endl;
+        test_common::testsFailed++;
+    }
+}
+
+void testRSAContext() {
+    test_common::printHeader("Test 5: RSA Precomputed Key Context");
+    
+    try {
+        RSAKey textbook(BigInteger(3233), BigInteger(17), BigInteger(2753),
+                        BigInteger(61), BigInteger(53));
+        RSA rsa(textbook);
+        
+        test_common::checkResult("RSA context uses CRT for full private key",
+                   ByteArray(1, 1),
+                   ByteArray(1, rsa.getContext()->usesCRT() ? 1 : 0));
+        
+        BigInteger c = rsa.getContext()->applyPublic(BigInteger(65));
+        test_common::checkResult("RSA context textbook encryption (65 -> 2790)",
+                   BigInteger(2790).toBytes(), c.toBytes());
+        
+        BigInteger m = rsa.getContext()->applyPrivate(c);
+        test_common::checkResult("RSA context textbook CRT decryption",
+                   BigInteger(65).toBytes(), m.toBytes());
+    } catch (const std::exception& e) {
+        std::cout << "  ✗ ERROR: RSA textbook context - " << e.what() << std::endl;
+        test_common::testsFailed++;
+    }
+    
+    try {
+        BigInteger modulus = BigInteger::random(160);
+        if (modulus.isEven()) {
+            modulus += BigInteger(1);
+        }
+        MontgomeryContext mont(modulus);
+        
+        bool allMatch = true;
+        for (int i = 0; i < 8; ++i) {
+            BigInteger base = BigInteger::random(200);
+            BigInteger exp = BigInteger::random(100 + i * 10);
+            if (mont.modPow(base, exp) != BigInteger::modPow(base, exp, modulus)) {
+                allMatch = false;
+            }
+        }
+        test_common::checkResult("Montgomery modPow matches BigInteger::modPow",
+                   ByteArray(1, 1), ByteArray(1, allMatch ? 1 : 0));
+    } catch (const std::exception& e) {
+        std::cout << "  ✗ ERROR: Montgomery modPow - " << e.what() << std::endl;
+        test_common::testsFailed++;
+    }
+    
+    RSAKey key;
+    try {
+        key = RSAKeyGenerator::generate(128);
+    } catch (const std::exception& e) {
+        std::cout << "  ⚠ SKIP: RSA context - Could not generate key: " << e.what() << std::endl;
+        return;
+    }
+    
+    try {
+        RSA crtRsa(key);
+        RSA plainRsa(RSAKey(key.n, key.e, key.d));
+        
+        ByteArray data = utils::stringToBytes("context");
+        ByteArray encrypted = crtRsa.encrypt(data);
+        test_common::checkResult("RSA CRT and non-CRT decryption agree",
+                   plainRsa.decrypt(encrypted), crtRsa.decrypt(encrypted));
+        
+        const RSA& shared = crtRsa;
+        std::vector<ByteArray> inputs(4), outputs(4);
+        std::vector<std::thread> workers;
+        for (size_t t = 0; t < inputs.size(); ++t) {
+            inputs[t] = math::randomBytes(shared.getBlockSize());
+            workers.emplace_back([&shared, &inputs, &outputs, t]() {
+                for (int round = 0; round < 10; ++round) {
+                    outputs[t] = shared.decryptBlock(shared.encryptBlock(inputs[t]));
+                }
+            });
+        }
+        for (std::thread& worker : workers) {
+            worker.join();
+        }
+        
+        bool allMatch = true;
+        for (size_t t = 0; t < inputs.size(); ++t) {
+            ByteArray expected = inputs[t];
+            while (expected.size() > 1 && expected[0] == 0) {
+                expected.erase(expected.begin());
+            }
+            allMatch = allMatch && expected == outputs[t];
+        }
+        test_common::checkResult("RSA context shared across threads",
+                   ByteArray(1, 1), ByteArray(1, allMatch ? 1 : 0));
+    } catch (const std::exception& e) {
+        std::cout << "  ✗ ERROR: RSA context - " << e.what() << std::endl;
+        test_common::testsFailed++;
+    }
+}
+
+void testRSAParallelKeyGeneration() {
+    test_common::printHeader("Test 6: RSA Parallel Key Generation");
+    
+    try {
+        ThreadPool pool(4);
+        RSAKey key = RSAKeyGenerator::generate(256, pool, 2);
+        
+        bool valid = key.p != key.q && key.p * key.q == key.n &&
+                     key.p.bitLength() == 128 && key.q.bitLength() == 128;
+        test_common::checkResult("RSA: Parallel search yields distinct primes of requested size",
+                   ByteArray(1, 1), ByteArray(1, valid ? 1 : 0));
+        
+        RSA rsa(key);
+        ByteArray data = utils::stringToBytes("parallel keygen");
+        test_common::checkResult("RSA: Parallel key encrypt/decrypt", data, rsa.decrypt(rsa.encrypt(data)));
+        
+        ThreadPool pair(2);
+        bool overlapped = false;
+        for (int attempt = 0; attempt < 5 && !overlapped; ++attempt) {
+            std::future<RSAKey> pending = std::async(std::launch::async, [&pair]() {
+                return RSAKeyGenerator::generate(768, pair, 1);
+            });
+            while (pending.wait_for(std::chrono::microseconds(100)) != std::future_status::ready) {
+                overlapped = overlapped || pair.activeTasks() > 0;
+            }
+            pending.get();
+        }
+        test_common::checkResult("RSA: One searcher per prime still searches p and q concurrently",
+                   ByteArray(1, 1), ByteArray(1, overlapped ? 1 : 0));
+        
+        ThreadPool singleWorker(1);
+        std::future<RSAKey> nested = singleWorker.enqueue([&singleWorker]() {
+            return RSAKeyGenerator::generate(128, singleWorker, 3);
+        });
+        RSAKey nestedKey = nested.get();
+        test_common::checkResult("RSA: Key generation from inside a saturated pool",
+                   ByteArray(1, 1),
+                   ByteArray(1, nestedKey.isPrivate() && nestedKey.p * nestedKey.q == nestedKey.n ? 1 : 0));
+    } catch (const std::exception& e) {
+        std::cout << "  ✗ ERROR: RSA parallel key generation - " << e.what() << std::endl;
+        test_common::testsFailed++;
+    }
+}
+
+void testRSAKeyPool() {
+    test_common::printHeader("Test 7: RSA Background Key Pool");
+    
+    try {
+        std::string path = "test_rsa_key_pool.txt";
+        BigInteger handedOut;
+        {
+            RSAKeyPool pool(1);
+            pool.setTarget(128, 2);
+            bool filled = pool.waitForKeys(128, 2, std::chrono::seconds(120));
+            test_common::checkResult("RSA key pool fills to target in background",
+                       ByteArray(1, 1), ByteArray(1, filled ? 1 : 0));
+            
+            RSAKey key;
+            bool acquired = pool.tryAcquire(128, key);
+            handedOut = key.n;
+            RSA rsa(key);
+            ByteArray data = utils::stringToBytes("pooled");
+            test_common::checkResult("RSA key pool hands out working key",
+                       data, acquired ? rsa.decrypt(rsa.encrypt(data)) : ByteArray());
+            
+            RSAKey missing;
+            test_common::checkResult("RSA key pool reports empty size",
+                       ByteArray(1, 0), ByteArray(1, pool.tryAcquire(256, missing) ? 1 : 0));
+            
+            pool.setTarget(128, 0);
+            pool.save(path);
+            test_common::checkResult("RSA key pool gives saved keys up",
+                       ByteArray(1, 0), ByteArray(1, static_cast<Byte>(pool.available(128))));
+            
+#if defined(__unix__) || defined(__APPLE__)
+            struct stat info {};
+            bool ownerOnly = stat(path.c_str(), &info) == 0 && (info.st_mode & 0777) == 0600;
+            test_common::checkResult("RSA key pool file is readable by its owner only",
+                       ByteArray(1, 1), ByteArray(1, ownerOnly ? 1 : 0));
+#endif
+            
+            std::ofstream mislabeled(path, std::ios::app);
+            mislabeled << 256 << ' ' << key.n.toHex() << ' ' << key.e.toHex() << ' ' << key.d.toHex()
+                       << ' ' << key.p.toHex() << ' ' << key.q.toHex() << '\n';
+        }
+        
+        RSAKeyPool restored(1);
+        size_t loaded = restored.load(path);
+        test_common::checkResult("RSA key pool restores persisted keys and skips a wrong size label",
+                   ByteArray(1, 1), ByteArray(1, static_cast<Byte>(loaded)));
+        test_common::checkResult("RSA key pool consumes the key file on load",
+                   ByteArray(1, 0), ByteArray(1, static_cast<Byte>(restored.load(path))));
+        
+        RSAKey key;
+        bool restoredKey = restored.tryAcquire(128, key);
+        test_common::checkResult("RSA key pool never restores a key it already handed out",
+                   ByteArray(1, 1), ByteArray(1, restoredKey && key.n != handedOut ? 1 : 0));
+        
+        RSA rsa(key);
+        ByteArray data = utils::stringToBytes("persisted");
+        test_common::checkResult("RSA persisted key encrypt/decrypt", data, rsa.decrypt(rsa.encrypt(data)));
+    } catch (const std::exception& e) {
+        std::cout << "  ✗ ERROR: RSA key pool - " << e.what() << std::endl;
+        test_common::testsFailed++;
+    }
+}
+
+void testRSAPrimality() {
+    test_common::printHeader("Test 8: RSA Baillie-PSW Primality Test");
+    
+    try {
+        BigInteger one(1);
+        std::vector<BigInteger> primes = {
+            BigInteger(2), BigInteger(3), BigInteger(97), BigInteger(65537),
+            BigInteger(static_cast<int64_t>(4294967291LL)),
+            (one << 61) - one, (one << 89) - one, (one << 127) - one
+        };
+        bool allPrime = true;
+        for (const BigInteger& p : primes) {
+            if (!RSAKeyGenerator::isProbablePrime(p)) {
+                allPrime = false;
+            }
+        }
+        test_common::checkResult("BPSW accepts known primes",
+                   ByteArray(1, 1), ByteArray(1, allPrime ? 1 : 0));
+        
+        std::vector<BigInteger> composites = {
+            BigInteger(0), BigInteger(1), BigInteger(561), BigInteger(2047),
+            BigInteger(280601), BigInteger(390937), BigInteger(1194649), BigInteger(12327121),
+            BigInteger(5459), BigInteger(161027), BigInteger(176399), BigInteger(288919),
+            BigInteger(static_cast<int64_t>(3825123056546413051LL)),
+            ((one << 61) - one) * ((one << 89) - one)
+        };
+        bool allComposite = true;
+        for (const BigInteger& c : composites) {
+            if (RSAKeyGenerator::isProbablePrime(c)) {
+                allComposite = false;
+            }
+        }
+        test_common::checkResult("BPSW rejects strong and Lucas pseudoprimes",
+                   ByteArray(1, 1), ByteArray(1, allComposite ? 1 : 0));
+    } catch (const std::exception& e) {
+        std::cout << "  ✗ ERROR: RSA primality - " << e.what() << std::endl;
+        test_common::testsFailed++;
+    }
+}
+
+void testRSASafePrimeGeneration() {
+    test_common::printHeader("Test 9: RSA Safe Prime Generation");
+    
+    try {
+        ThreadPool pool(2);
+        bool allSafe = true;
+        for (size_t bits : {32, 64, 160}) {
+            BigInteger p = RSAKeyGenerator::generateSafePrime(bits, pool);
+            BigInteger q = (p - BigInteger(1)) >> 1;
+            if (p.bitLength() != bits || !RSAKeyGenerator::isProbablePrime(p) ||
+                !RSAKeyGenerator::isProbablePrime(q)) {
+                allSafe = false;
+            }
+        }
+        test_common::checkResult("Safe primes have prime (p - 1) / 2",
+                   ByteArray(1, 1), ByteArray(1, allSafe ? 1 : 0));
+        
+        bool rejected = false;
+        try {
+            RSAKeyGenerator::generateSafePrime(16, pool);
+        } catch (const CryptoException&) {
+            rejected = true;
+        }
+        test_common::checkResult("Safe prime rejects sizes below 32 bits",
+                   ByteArray(1, 1), ByteArray(1, rejected ? 1 : 0));
+    } catch (const std::exception& e) {
+        std::cout << "  ✗ ERROR: RSA safe prime - " << e.what() << std::endl;
+        test_common::testsFailed++;
+    }
+}
+
+void testRSABatchGCD() {
+    test_common::printHeader("Test 10: RSA Batch GCD Shared Factor Audit");
+    
+    try {
+        ThreadPool pool(2);
+        std::vector<RSAKey> keys;
+        for (int i = 0; i < 4; ++i) {
+            keys.push_back(RSAKeyGenerator::generate(128, pool));
+        }
+        
+        std::vector<BigInteger> moduli = {
+            keys[0].n, keys[1].n, keys[0].p * keys[2].q, keys[3].n, keys[2].n
+        };
+        std::vector<BigInteger> gcds = BatchGCD::computeGcds(moduli, pool);
+        
+        bool expected = gcds[0] == keys[0].p && gcds[1].isOne() && gcds[2] == moduli[2] &&
+                        gcds[3].isOne() && gcds[4] == keys[2].q;
+        test_common::checkResult("Batch GCD finds shared primes",
+                   ByteArray(1, 1), ByteArray(1, expected ? 1 : 0));
+        
+        bool matchesPairwise = true;
+        for (size_t i = 0; i < moduli.size(); ++i) {
+            BigInteger others(1);
+            for (size_t j = 0; j < moduli.size(); ++j) {
+                if (j != i) {
+                    others = others * moduli[j];
+                }
+            }
+            if (BigInteger::gcd(moduli[i], others) != gcds[i]) {
+                matchesPairwise = false;
+            }
+        }
+        test_common::checkResult("Batch GCD matches direct gcd with product of others",
+                   ByteArray(1, 1), ByteArray(1, matchesPairwise ? 1 : 0));
+        
+        std::string path = "test_rsa_batch_gcd.txt";
+        {
+            std::ofstream output(path);
+            output << "# audit corpus\n";
+            for (const BigInteger& n : moduli) {
+                output << n.toHex() << " 10001\n";
+            }
+        }
+        std::vector<SharedFactor> weak = BatchGCD::auditFile(path, pool);
+        std::remove(path.c_str());
+        
+        bool reported = weak.size() == 3 && weak[0].index == 0 && weak[1].index == 2 &&
+                        weak[2].index == 4 && weak[2].factor == keys[2].q;
+        test_common::checkResult("Batch GCD audit reads moduli from file",
+                   ByteArray(1, 1), ByteArray(1, reported ? 1 : 0));
+    } catch (const std::exception& e) {
+        std::cout << "  ✗ ERROR: RSA batch GCD - " << e.what() << std::endl;
+        test_common::testsFailed++;
+    }
+}
+
+void testRSAWienerAuditor() {
+    test_common::printHeader("Test 11: RSA Batch Wiener Audit");
+    
+    try {
+        ThreadPool pool(2);
+        RSAKey weak1 = RSAKeyGenerator::generate(256, pool);
+        RSAKey weak2 = RSAKeyGenerator::generate(384, pool);
+        RSAKey strong = RSAKeyGenerator::generate(256, pool);
+        BigInteger d1, d2, d3;
+        BigInteger e1 = wienerExponent(weak1, 48, d1);
+        BigInteger e2 = wienerExponent(weak2, 64, d2);
+        BigInteger e3 = wienerExponent(strong, 200, d3);
+        
+        std::string path = "test_rsa_wiener_audit.txt";
+        {
+            std::ofstream output(path);
+            output << "# n e\n";
+            output << strong.n.toHex() << ' ' << strong.e.toHex() << '\n';
+            output << weak1.n.toHex() << ' ' << e1.toHex() << '\n';
+            output << "zz 10001\n";
+            output << strong.n.toHex() << ' ' << e3.toHex() << '\n';
+            output << weak2.n.toHex() << ' ' << e2.toHex() << '\n';
+        }
+        WienerAuditReport report = WienerAuditor::auditFile(path, pool, 2);
+        std::remove(path.c_str());
+        
+        test_common::checkResult("Wiener audit counts keys and malformed lines",
+                   ByteArray(1, 1),
+                   ByteArray(1, report.keysRead == 5 && report.malformed == 1 ? 1 : 0));
+        test_common::checkResult("Wiener audit prefilter skips small public exponents",
+                   ByteArray(1, 1), ByteArray(1, report.attacked == 3 ? 1 : 0));
+        
+        bool found = report.vulnerable.size() == 2 &&
+                     report.vulnerable[0].line == 3 && report.vulnerable[0].d == d1 &&
+                     report.vulnerable[1].line == 6 && report.vulnerable[1].d == d2 &&
+                     report.vulnerable[1].p * report.vulnerable[1].q == weak2.n;
+        test_common::checkResult("Wiener audit reports vulnerable keys by line",
+                   ByteArray(1, 1), ByteArray(1, found ? 1 : 0));
+        
+        WienerAuditReport direct = WienerAuditor::audit({{weak1.n, e1}, {strong.n, strong.e}}, pool);
+        test_common::checkResult("Wiener audit of in-memory keys",
+                   ByteArray(1, 1),
+                   ByteArray(1, direct.vulnerable.size() == 1 && direct.vulnerable[0].line == 1 ? 1 : 0));
+        
+        std::cout << "  Audited " << report.keysRead << " keys in " << report.elapsedSeconds
+                  << " s (slowest attack " << report.slowestAttackSeconds << " s)" << std::endl;
+    } catch (const std::exception& e) {
+        std::cout << "  ✗ ERROR: RSA Wiener audit - " << e.what() << std::endl;
+        test_common::testsFailed++;
+    }
+}
+
+static BigInteger nextPrime(BigInteger n) {
+    if (n.isEven()) {
+        n += BigInteger(1);
+    }
+    while (!RSAKeyGenerator::isProbablePrime(n)) {
+        n += BigInteger(2);
+    }
+    return n;
+}
+
+void testRSAFermatFactorization() {
+    test_common::printHeader("Test 12: RSA Integer Roots and Fermat Factorization");
+    
+    try {
+        BigInteger base = BigInteger::random(300);
+        BigInteger square = base * base;
+        BigInteger cube = BigInteger::pow(base, 3);
+        BigInteger root;
+        uint32_t exponent = 0;
+        bool roots = BigInteger::isqrt(square) == base &&
+                     BigInteger::isqrt(square - BigInteger(1)) == base - BigInteger(1) &&
+                     BigInteger::iroot(cube, 3) == base &&
+                     BigInteger::iroot(cube + base, 3) == base &&
+                     BigInteger::iroot(cube - BigInteger(1), 3) == base - BigInteger(1);
+        test_common::checkResult("Newton isqrt and iroot give floor roots",
+                   ByteArray(1, 1), ByteArray(1, roots ? 1 : 0));
+        
+        bool squares = BigInteger::isPerfectSquare(square, root) && root == base &&
+                       !BigInteger::isPerfectSquare(square + BigInteger(1)) &&
+                       !BigInteger::isPerfectSquare(square - BigInteger(1));
+        bool powers = BigInteger::isPerfectPower(BigInteger::pow(BigInteger(6), 35), root, exponent) &&
+                      root == BigInteger(6) && exponent == 35 &&
+                      !BigInteger::isPerfectPower(cube + BigInteger(1), root, exponent);
+        test_common::checkResult("Perfect square and perfect power detection",
+                   ByteArray(1, 1), ByteArray(1, squares && powers ? 1 : 0));
+        
+        BigInteger p = nextPrime((BigInteger(1) << 63) + BigInteger::random(62));
+        BigInteger q = nextPrime(p + (BigInteger(1) << 38));
+        BigInteger n = p * q;
+        
+        BigInteger p1, q1, p2, q2;
+        ThreadPool pool(3);
+        bool serial = FermatFactorizer::factor(n, p1, q1, 1 << 16);
+        bool parallel = FermatFactorizer::factor(n, p2, q2, 1 << 16, pool);
+        test_common::checkResult("Fermat factors close primes",
+                   ByteArray(1, 1),
+                   ByteArray(1, serial && parallel && p1 == q && q1 == p && p2 == q && q2 == p ? 1 : 0));
+        
+        BigInteger r = nextPrime(p << 32);
+        bool distant = FermatFactorizer::factor(p * r, p1, q1, 1000, pool);
+        bool prime = FermatFactorizer::factor(q, p1, q1, 1000);
+        test_common::checkResult("Fermat gives up on distant factors and primes",
+                   ByteArray(1, 0), ByteArray(1, distant || prime ? 1 : 0));
+    } catch (const std::exception& e) {
+        std::cout << "  ✗ ERROR: RSA Fermat factorization - " << e.what() << std::endl;
+        test_common::testsFailed++;
+    }
+}
+
+void testRSAPollardFactorization() {
+    test_common::printHeader("Test 13: RSA Pollard Rho and p-1 Factorization");
+    
+    try {
+        ThreadPool pool(3);
+        RSAKey key = RSAKeyGenerator::generate(64);
+        BigInteger f1, f2;
+        bool serial = PollardFactorizer::rho(key.n, f1, 1 << 24);
+        bool parallel = PollardFactorizer::rho(key.n, f2, 1 << 24, pool);
+        bool factors = (f1 == key.p || f1 == key.q) && (f2 == key.p || f2 == key.q);
+        test_common::checkResult("Pollard rho factors a 64-bit modulus",
+                   ByteArray(1, 1), ByteArray(1, serial && parallel && factors ? 1 : 0));
+        
+        const std::vector<uint32_t>& primes = crypto::math::smallPrimes();
+        BigInteger smooth(2);
+        for (size_t i = 1 + BigInteger::random(5).modSmall(16); smooth.bitLength() < 100; ++i) {
+            smooth = smooth * BigInteger(static_cast<int64_t>(primes[i]));
+        }
+        BigInteger p = smooth + BigInteger(1);
+        while (!RSAKeyGenerator::isProbablePrime(p)) {
+            p += smooth;
+        }
+        BigInteger q = nextPrime(BigInteger::random(160));
+        
+        BigInteger factor;
+        bool found = PollardFactorizer::pMinusOne(p * q, factor, 1 << 18);
+        test_common::checkResult("Pollard p-1 finds a prime with smooth p-1",
+                   ByteArray(1, 1), ByteArray(1, found && factor == p ? 1 : 0));
+        
+        bool prime = PollardFactorizer::pMinusOne(q, factor, 1000) ||
+                     PollardFactorizer::rho(q, factor, 10000, pool);
+        test_common::checkResult("Pollard methods find no factor of a prime",
+                   ByteArray(1, 0), ByteArray(1, prime ? 1 : 0));
+    } catch (const std::exception& e) {
+        std::cout << "  ✗ ERROR: RSA Pollard factorization - " << e.what() << std::endl;
+        test_common::testsFailed++;
+    }
+}
+
+static BigInteger randomOfExactBits(size_t bits) {
+    BigInteger value = BigInteger::random(bits);
+    if (!value.testBit(bits - 1)) {
+        value += BigInteger(1) << (bits - 1);
+    }
+    return value;
+}
+
+void testRSALargeArithmetic() {
+    test_common::printHeader("Test 14: RSA Karatsuba Multiplication and Newton Division");
+    
+    try {
+        bool products = true;
+        const size_t productSizes[][2] = {{2048, 2048}, {4096, 4096}, {8192, 3000}, {16384, 16384}};
+        for (const auto& sizes : productSizes) {
+            BigInteger a = randomOfExactBits(sizes[0]);
+            BigInteger b = randomOfExactBits(sizes[1]);
+            
+            // One 32-bit word of b at a time keeps every partial product on the schoolbook path.
+            BigInteger schoolbook;
+            for (size_t shift = 0; shift < sizes[1]; shift += 32) {
+                BigInteger word = (b >> shift) % (BigInteger(1) << 32);
+                schoolbook += (a * word) << shift;
+            }
+            products = products && a * b == schoolbook && b * a == schoolbook;
+        }
+        test_common::checkResult("Karatsuba products match schoolbook multiplication",
+                   ByteArray(1, 1), ByteArray(1, products ? 1 : 0));
+        
+        bool divisions = true;
+        const size_t divisionSizes[][2] = {{12288, 4096}, {16384, 8192}, {24576, 8192}};
+        for (const auto& sizes : divisionSizes) {
+            BigInteger b = randomOfExactBits(sizes[1]);
+            BigInteger k = randomOfExactBits(sizes[0] - sizes[1]);
+            const BigInteger dividends[] = {randomOfExactBits(sizes[0]), b * k - BigInteger(1), b * k};
+            for (const BigInteger& a : dividends) {
+                BigInteger q = a / b;
+                BigInteger r = a % b;
+                divisions = divisions && q * b + r == a && r < b && r >= BigInteger(0);
+            }
+            divisions = divisions && (b * k - BigInteger(1)) / b == k - BigInteger(1) &&
+                        (b * k) % b == BigInteger(0);
+        }
+        test_common::checkResult("Newton division satisfies q*b + r == a with r < b",
+                   ByteArray(1, 1), ByteArray(1, divisions ? 1 : 0));
+    } catch (const std::exception& e) {
+        std::cout << "  ✗ ERROR: RSA large arithmetic - " << e.what() << std::endl;
+        test_common::testsFailed++;
+    }
 }
 
 int main() {
@@ -224,6 +820,16 @@ int main() {
         testRSAKeyGeneration();
         testRSADataSizes();
         testRSAWienerAttack();
+        testRSAContext();
+        testRSAParallelKeyGeneration();
+        testRSAKeyPool();
+        testRSAPrimality();
+        testRSASafePrimeGeneration();
+        testRSABatchGCD();
+        testRSAWienerAuditor();
+        testRSAFermatFactorization();
+        testRSAPollardFactorization();
+        testRSALargeArithmetic();
         
         test_common::printSummary();
         